@@ -0,0 +1,89 @@
+///
+/// \file 				Benchmark.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains a minimal harness for the CppUtils benchmarks.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_BENCHMARK_H_
+#define MN_CPP_UTILS_BENCHMARK_H_
+
+// System includes
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mn {
+    namespace CppUtils {
+        namespace Benchmark {
+
+            using Clock = std::chrono::steady_clock;
+
+            /// \brief      Holds all benchmarks registered with the BENCHMARK() macro.
+            class Registry {
+            public:
+
+                static Registry& Instance() {
+                    static Registry registry;
+                    return registry;
+                }
+
+                void Add(const std::string& name, std::function<void()> benchmark) {
+                    benchmarks_.push_back(std::make_pair(name, benchmark));
+                }
+
+                /// \brief      Runs every benchmark who's name contains filter (all of them if filter is empty).
+                void Run(const std::string& filter) {
+                    for(auto& benchmark : benchmarks_) {
+                        if(!filter.empty() && benchmark.first.find(filter) == std::string::npos)
+                            continue;
+                        std::printf("[ RUN      ] %s\n", benchmark.first.c_str());
+                        benchmark.second();
+                    }
+                }
+
+            private:
+                std::vector<std::pair<std::string, std::function<void()>>> benchmarks_;
+            };
+
+            /// \brief      Registers a benchmark with the registry at static initialisation time.
+            class Registrar {
+            public:
+                Registrar(const std::string& name, std::function<void()> benchmark) {
+                    Registry::Instance().Add(name, benchmark);
+                }
+            };
+
+            /// \brief      Calls func once and returns how long it took.
+            template<typename F>
+            Clock::duration Time(F&& func) {
+                auto startTime = Clock::now();
+                func();
+                return Clock::now() - startTime;
+            }
+
+            /// \brief      Prints the throughput of numOps operations that took elapsed time.
+            inline void Report(const std::string& name, std::size_t numOps, Clock::duration elapsed) {
+                auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+                double opsPerSec = elapsed_ns > 0 ? numOps * 1e9 / elapsed_ns : 0.0;
+                std::printf("    %-40s %10zu ops %12.3f ms %10.1f ns/op %14.0f ops/s\n", name.c_str(), numOps,
+                            elapsed_ns / 1e6, numOps > 0 ? static_cast<double>(elapsed_ns) / numOps : 0.0, opsPerSec);
+            }
+
+        } // namespace Benchmark
+    } // namespace CppUtils
+} // namespace mn
+
+/// \brief      Defines and registers a benchmark function.
+#define BENCHMARK(name) \
+    static void name(); \
+    static mn::CppUtils::Benchmark::Registrar name##_registrar(#name, &name); \
+    static void name()
+
+#endif // MN_CPP_UTILS_BENCHMARK_H_
@@ -0,0 +1,160 @@
+///
+/// \file 				EventBenchmarks.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains benchmarks for the Event, ConcurrentEvent, AsyncEvent and StaticEvent classes.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// User includes
+#include "Benchmark.hpp"
+#include "CppUtils/AsyncEvent.hpp"
+#include "CppUtils/ConcurrentEvent.hpp"
+#include "CppUtils/Event.hpp"
+#include "CppUtils/StaticEvent.hpp"
+
+using namespace mn::CppUtils;
+using namespace mn::CppUtils::Benchmark;
+
+namespace {
+
+    constexpr std::size_t NUM_FIRES = 1000000;
+
+    using Packet = std::vector<uint8_t>;
+
+    /// \brief      A listener which captures more than std::function can store inline, like a typical bound
+    ///             method with some context, so copying it allocates.
+    struct Listener {
+        /// \brief      Volatile, so the compiler cannot optimise the listener away.
+        volatile uint64_t* sum_;
+        uint64_t context_[4];
+
+        void operator()(const Packet& packet) {
+            *sum_ += packet.size() + context_[0];
+        }
+    };
+
+    /// \brief      A slow listener, like one updating a UI or statistics, which takes about a microsecond.
+    struct SlowListener {
+        volatile uint64_t* sum_;
+
+        void operator()(const Packet& packet) {
+            for(std::size_t i = 0; i < 250; i++)
+                *sum_ += packet.size();
+        }
+    };
+
+}  // namespace
+
+BENCHMARK(Event_Fire_VsNumListeners) {
+    Packet packet(64);
+    volatile uint64_t sum = 0;
+
+    for(std::size_t numListeners : { 1, 4, 16, 64 }) {
+        Event<void(const Packet&)> event;
+        std::vector<std::function<void(const Packet&)>> listeners;
+        for(std::size_t i = 0; i < numListeners; i++) {
+            event.AddListener(Listener{ &sum, { i } });
+            listeners.push_back(Listener{ &sum, { i } });
+        }
+
+        // What Fire() used to do, copy every listener on every fire
+        Report("Copying dispatch, " + std::to_string(numListeners) + " listeners", NUM_FIRES / numListeners, Time([&]() {
+            for(std::size_t i = 0; i < NUM_FIRES / numListeners; i++) {
+                for(auto listener : listeners)
+                    listener(packet);
+            }
+        }));
+
+        Report("Fire(), " + std::to_string(numListeners) + " listeners", NUM_FIRES / numListeners, Time([&]() {
+            for(std::size_t i = 0; i < NUM_FIRES / numListeners; i++)
+                event.Fire(packet);
+        }));
+    }
+}
+
+BENCHMARK(ConcurrentEvent_Fire_VsLockedEvent) {
+    constexpr std::size_t NUM_LISTENERS = 4;
+    Packet packet(64);
+    volatile uint64_t sum = 0;
+
+    Event<void(const Packet&)> event;
+    ConcurrentEvent<void(const Packet&)> concurrentEvent;
+    for(std::size_t i = 0; i < NUM_LISTENERS; i++) {
+        event.AddListener(Listener{ &sum, { i } });
+        concurrentEvent.AddListener(Listener{ &sum, { i } });
+    }
+
+    // The alternative to ConcurrentEvent, an Event with every fire and listener change behind a mutex
+    std::mutex mutex;
+    Report("Event + std::mutex Fire()", NUM_FIRES, Time([&]() {
+        for(std::size_t i = 0; i < NUM_FIRES; i++) {
+            std::lock_guard<std::mutex> lock(mutex);
+            event.Fire(packet);
+        }
+    }));
+
+    Report("ConcurrentEvent Fire()", NUM_FIRES, Time([&]() {
+        for(std::size_t i = 0; i < NUM_FIRES; i++)
+            concurrentEvent.Fire(packet);
+    }));
+}
+
+BENCHMARK(AsyncEvent_Fire_VsEvent) {
+    constexpr std::size_t NUM_SLOW_FIRES = 100000;
+    Packet packet(64);
+    volatile uint64_t sum = 0;
+
+    // Only the producer's time is reported, delivery happens on the executor (and is waited for outside the timing)
+    Event<void(const Packet&)> event;
+    event.AddListener(SlowListener{ &sum });
+    Report("Event Fire()", NUM_SLOW_FIRES, Time([&]() {
+        for(std::size_t i = 0; i < NUM_SLOW_FIRES; i++)
+            event.Fire(packet);
+    }));
+
+    auto executor = std::make_shared<ThreadPoolExecutor>(1);
+    for(auto policy : { CoalescePolicy::None, CoalescePolicy::LastValueWins }) {
+        AsyncEvent<void(const Packet&)> asyncEvent(executor, policy);
+        asyncEvent.AddListener(SlowListener{ &sum });
+        Report(std::string("AsyncEvent Fire(), ") + (policy == CoalescePolicy::None ? "None" : "LastValueWins"),
+               NUM_SLOW_FIRES, Time([&]() {
+            for(std::size_t i = 0; i < NUM_SLOW_FIRES; i++)
+                asyncEvent.Fire(packet);
+        }));
+        asyncEvent.Flush();
+    }
+}
+
+BENCHMARK(StaticEvent_Fire_VsEvent) {
+    constexpr std::size_t NUM_LISTENERS = 4;
+    Packet packet(64);
+    volatile uint64_t sum = 0;
+
+    Event<void(const Packet&)> event;
+    for(std::size_t i = 0; i < NUM_LISTENERS; i++)
+        event.AddListener(Listener{ &sum, { i } });
+
+    StaticEvent<Listener, Listener, Listener, Listener> staticEvent(
+            Listener{ &sum, { 0 } }, Listener{ &sum, { 1 } }, Listener{ &sum, { 2 } }, Listener{ &sum, { 3 } });
+
+    Report("Event Fire(), 4 listeners", NUM_FIRES, Time([&]() {
+        for(std::size_t i = 0; i < NUM_FIRES; i++)
+            event.Fire(packet);
+    }));
+
+    Report("StaticEvent Fire(), 4 listeners", NUM_FIRES, Time([&]() {
+        for(std::size_t i = 0; i < NUM_FIRES; i++)
+            staticEvent.Fire(packet);
+    }));
+}
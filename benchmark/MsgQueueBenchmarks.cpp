@@ -0,0 +1,95 @@
+///
+/// \file 				MsgQueueBenchmarks.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains benchmarks for the MsgQueue class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <thread>
+
+// User includes
+#include "Benchmark.hpp"
+#include "CppUtils/MsgQueue.hpp"
+
+using namespace mn::CppUtils::MsgQueue;
+using namespace mn::CppUtils::Benchmark;
+
+namespace {
+
+    constexpr std::size_t NUM_MSGS = 1000000;
+
+    struct Position {
+        double x_;
+        double y_;
+    };
+
+}  // namespace
+
+BENCHMARK(MsgQueue_PushPop_SharedPtrVsPayload) {
+    MsgQueue queue;
+    RxMsg msg;
+    volatile double sum = 0.0;
+
+    Report("Push()/Pop(), std::shared_ptr<void> data", NUM_MSGS, Time([&]() {
+        for(std::size_t i = 0; i < NUM_MSGS; i++) {
+            queue.Push(TxMsg("POSITION"_msgId, std::make_shared<Position>(Position{ 1.0, 2.0 })));
+            queue.Pop(msg);
+            sum = sum + std::static_pointer_cast<Position>(msg.GetData())->x_;
+        }
+    }));
+
+    Report("Push()/Pop(), inline Payload", NUM_MSGS, Time([&]() {
+        for(std::size_t i = 0; i < NUM_MSGS; i++) {
+            queue.Push(TxMsg("POSITION"_msgId, Position{ 1.0, 2.0 }));
+            queue.Pop(msg);
+            sum = sum + msg.GetPayload().Get<Position>().x_;
+        }
+    }));
+}
+
+BENCHMARK(MsgQueue_RequestReply_PromiseVsReplyChannel) {
+    constexpr std::size_t NUM_REQUESTS = 100000;
+    MsgQueue queue;
+
+    // The server doubles the value in each request, replying the way the request asks it to
+    std::thread server([&]() {
+        RxMsg msg;
+        while(true) {
+            queue.Pop(msg);
+            if(msg.GetId() == "EXIT"_msgId)
+                return;
+            if(auto promise = msg.GetPayload().GetIf<std::shared_ptr<std::promise<int>>>())
+                (*promise)->set_value(1);
+            else
+                msg.ReturnPayload(msg.GetPayload().Get<int>() * 2);
+        }
+    });
+
+    // What a request returning data used to cost, a std::promise and std::future per request
+    Report("std::promise/std::future round trip", NUM_REQUESTS, Time([&]() {
+        for(std::size_t i = 0; i < NUM_REQUESTS; i++) {
+            auto promise = std::make_shared<std::promise<int>>();
+            auto future = promise->get_future();
+            queue.Push(TxMsg("DOUBLE"_msgId, Payload(std::move(promise))));
+            future.get();
+        }
+    }));
+
+    Report("ReplyChannel round trip", NUM_REQUESTS, Time([&]() {
+        for(std::size_t i = 0; i < NUM_REQUESTS; i++) {
+            TxMsg request("DOUBLE"_msgId, static_cast<int>(i), ReturnType::RETURN_DATA);
+            queue.Push(request);
+            request.WaitForReply();
+        }
+    }));
+
+    queue.Push(TxMsg("EXIT"_msgId));
+    server.join();
+}
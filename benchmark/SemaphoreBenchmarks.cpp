@@ -0,0 +1,115 @@
+///
+/// \file 				SemaphoreBenchmarks.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains benchmarks for the Semaphore and FutexSemaphore classes.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// User includes
+#include "Benchmark.hpp"
+#include "CppUtils/FutexSemaphore.hpp"
+#include "CppUtils/Semaphore.hpp"
+
+using namespace mn::CppUtils;
+using namespace mn::CppUtils::Benchmark;
+
+namespace {
+
+    constexpr std::size_t NUM_OPS = 100000;
+
+    /// \brief      Bounces a notification back and forth between two threads, and reports the time per round trip.
+    template<typename SemaphoreType>
+    void PingPong(const std::string& name) {
+        SemaphoreType ping;
+        SemaphoreType pong;
+
+        std::thread thread([&]() {
+            for(std::size_t i = 0; i < NUM_OPS; i++) {
+                ping.Wait();
+                pong.Notify();
+            }
+        });
+
+        Report(name, NUM_OPS, Time([&]() {
+            for(std::size_t i = 0; i < NUM_OPS; i++) {
+                ping.Notify();
+                pong.Wait();
+            }
+        }));
+
+        thread.join();
+    }
+
+    /// \brief      Notifies and then waits on one thread, so Wait() never has to block.
+    template<typename SemaphoreType>
+    void Uncontended(const std::string& name) {
+        SemaphoreType semaphore;
+        Report(name, NUM_OPS, Time([&]() {
+            for(std::size_t i = 0; i < NUM_OPS; i++) {
+                semaphore.Notify();
+                semaphore.Wait();
+            }
+        }));
+    }
+
+    /// \brief      Hands permits from one thread to another BATCH_SIZE at a time, either one per call or the whole
+    ///             batch in one call, and reports the time per permit.
+    template<typename SemaphoreType>
+    void Batch(const std::string& name, bool useBatchCalls) {
+        constexpr uint32_t BATCH_SIZE = 64;
+        SemaphoreType items;
+        SemaphoreType done;
+
+        std::thread thread([&]() {
+            for(std::size_t i = 0; i < NUM_OPS / BATCH_SIZE; i++) {
+                if(useBatchCalls) {
+                    items.Wait(BATCH_SIZE);
+                } else {
+                    for(uint32_t j = 0; j < BATCH_SIZE; j++)
+                        items.Wait();
+                }
+                done.Notify();
+            }
+        });
+
+        Report(name, NUM_OPS / BATCH_SIZE * BATCH_SIZE, Time([&]() {
+            for(std::size_t i = 0; i < NUM_OPS / BATCH_SIZE; i++) {
+                if(useBatchCalls) {
+                    items.Notify(BATCH_SIZE);
+                } else {
+                    for(uint32_t j = 0; j < BATCH_SIZE; j++)
+                        items.Notify();
+                }
+                done.Wait();
+            }
+        }));
+
+        thread.join();
+    }
+
+}  // namespace
+
+BENCHMARK(Semaphore_Uncontended_VsFutexSemaphore) {
+    Uncontended<Semaphore>("Semaphore Notify() + Wait()");
+    Uncontended<FutexSemaphore>("FutexSemaphore Notify() + Wait()");
+}
+
+BENCHMARK(Semaphore_PingPong_VsFutexSemaphore) {
+    PingPong<Semaphore>("Semaphore round trip");
+    PingPong<FutexSemaphore>("FutexSemaphore round trip");
+}
+
+BENCHMARK(Semaphore_Batch_VsPerPermit) {
+    Batch<Semaphore>("Semaphore 64 x Notify() / Wait()", false);
+    Batch<Semaphore>("Semaphore Notify(64) / Wait(64)", true);
+    Batch<FutexSemaphore>("FutexSemaphore 64 x Notify() / Wait()", false);
+    Batch<FutexSemaphore>("FutexSemaphore Notify(64) / Wait(64)", true);
+}
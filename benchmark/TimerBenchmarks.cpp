@@ -0,0 +1,39 @@
+///
+/// \file 				TimerBenchmarks.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains benchmarks for the Timer class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <chrono>
+#include <thread>
+
+// User includes
+#include "Benchmark.hpp"
+#include "CppUtils/Timer.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils;
+using namespace mn::CppUtils::Benchmark;
+
+BENCHMARK(Timer_CreateDestroy_VsThreadSpawn) {
+    constexpr std::size_t NUM_TIMERS = 10000;
+
+    // What every Timer used to cost, a thread spawn and join
+    Report("std::thread spawn + join", NUM_TIMERS, Time([&]() {
+        for(std::size_t i = 0; i < NUM_TIMERS; i++)
+            std::thread([]() {}).join();
+    }));
+
+    // Create the shared timer thread before timing
+    { Timer timer(1s, []() {}); }
+
+    Report("Timer create + destroy", NUM_TIMERS, Time([&]() {
+        for(std::size_t i = 0; i < NUM_TIMERS; i++)
+            Timer timer(1s, []() {});
+    }));
+}
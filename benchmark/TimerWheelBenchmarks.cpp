@@ -0,0 +1,114 @@
+///
+/// \file 				TimerWheelBenchmarks.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains benchmarks for the TimerWheel class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// User includes
+#include "Benchmark.hpp"
+#include "CppUtils/TimerWheel.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils::Benchmark;
+using namespace mn::CppUtils::TimerWheel;
+
+namespace {
+
+    constexpr std::size_t NUM_TIMERS = 100000;
+
+    /// \brief      Random durations between 1 and 10s, so that no timers expire during the benchmark, but new
+    ///             timers regularly expire before all the ones already added (and so need to wake up the
+    ///             timer wheel thread).
+    std::vector<std::chrono::microseconds> MakeDurations() {
+        std::minstd_rand random(1);
+        std::uniform_int_distribution<int64_t> distribution(1000000, 10000000);
+        std::vector<std::chrono::microseconds> durations;
+        for(std::size_t i = 0; i < NUM_TIMERS; i++)
+            durations.push_back(std::chrono::microseconds(distribution(random)));
+        return durations;
+    }
+
+    /// \brief      Adds and removes all the timers once, so the timer pool has already grown to it's full size
+    ///             before anything is timed.
+    void WarmUp(TimerWheel& timerWheel, const std::vector<std::chrono::microseconds>& durations) {
+        std::vector<TimerHandle> timerHandles;
+        timerHandles.reserve(durations.size());
+        for(auto duration : durations)
+            timerHandles.push_back(timerWheel.AddSingleShotTimer(duration, []() {}));
+        timerWheel.RemoveTimers(timerHandles.begin(), timerHandles.end());
+    }
+
+}  // namespace
+
+BENCHMARK(TimerWheel_AddRemove_PerCallVsBatch) {
+    auto durations = MakeDurations();
+    auto onExpiry = []() {};
+
+    {
+        TimerWheel timerWheel;
+        std::vector<TimerHandle> timerHandles;
+        timerHandles.reserve(NUM_TIMERS);
+        WarmUp(timerWheel, durations);
+
+        Report("AddSingleShotTimer() per call", NUM_TIMERS, Time([&]() {
+            for(auto duration : durations)
+                timerHandles.push_back(timerWheel.AddSingleShotTimer(duration, onExpiry));
+        }));
+
+        Report("RemoveTimer() per call", NUM_TIMERS, Time([&]() {
+            for(auto timerHandle : timerHandles)
+                timerWheel.RemoveTimer(timerHandle);
+        }));
+    }
+
+    {
+        TimerWheel timerWheel;
+        std::vector<TimerHandle> timerHandles;
+        timerHandles.reserve(NUM_TIMERS);
+        std::vector<TimerSpec> timerSpecs;
+        timerSpecs.reserve(NUM_TIMERS);
+        for(auto duration : durations)
+            timerSpecs.push_back(TimerSpec::SingleShot(duration, onExpiry));
+        WarmUp(timerWheel, durations);
+
+        Report("AddTimers() batch", NUM_TIMERS, Time([&]() {
+            timerWheel.AddTimers(timerSpecs.begin(), timerSpecs.end(), std::back_inserter(timerHandles));
+        }));
+
+        Report("RemoveTimers() batch", NUM_TIMERS, Time([&]() {
+            timerWheel.RemoveTimers(timerHandles.begin(), timerHandles.end());
+        }));
+    }
+}
+
+BENCHMARK(TimerWheel_Restart_VsRemoveAndAdd) {
+    auto durations = MakeDurations();
+    auto onExpiry = []() {};
+
+    TimerWheel timerWheel;
+    WarmUp(timerWheel, durations);
+
+    // Push back one watchdog timer over and over, as if on every received packet
+    auto timerHandle = timerWheel.AddSingleShotTimer(durations[0], onExpiry);
+    Report("RemoveTimer() + AddSingleShotTimer()", NUM_TIMERS, Time([&]() {
+        for(auto duration : durations) {
+            timerWheel.RemoveTimer(timerHandle);
+            timerHandle = timerWheel.AddSingleShotTimer(duration, onExpiry);
+        }
+    }));
+
+    Report("RestartTimer()", NUM_TIMERS, Time([&]() {
+        for(auto duration : durations)
+            timerWheel.RestartTimer(timerHandle, duration);
+    }));
+}
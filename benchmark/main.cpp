@@ -0,0 +1,23 @@
+///
+/// \file 				main.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the main entry point for the benchmark application.
+/// \details
+///		See README.md in root dir for more info.
+///     Usage: CppUtilBenchmarks [filter]. Only benchmarks who's name contains filter are run.
+
+// System includes
+#include <string>
+
+// User includes
+#include "Benchmark.hpp"
+
+int main(int argc, char **argv) {
+
+	std::string filter = argc > 1 ? argv[1] : "";
+	mn::CppUtils::Benchmark::Registry::Instance().Run(filter);
+	return 0;
+}
@@ -0,0 +1,240 @@
+///
+/// \file 				AsyncEvent.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the AsyncEvent class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_ASYNC_EVENT_H_
+#define MN_CPP_UTILS_ASYNC_EVENT_H_
+
+// System includes
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// User includes
+#include "ConcurrentEvent.hpp"
+#include "Executor.hpp"
+#include "Subscription.hpp"
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      What AsyncEvent::Fire() does when the event is fired again before the previous fire has been
+        ///             delivered to the listeners.
+        enum class CoalescePolicy {
+            None,           ///< Every fire is delivered, in order.
+            LastValueWins,  ///< Fires waiting to be delivered are replaced by the latest one.
+            Accumulate,     ///< Fires waiting to be delivered are merged into one by an accumulator function.
+        };
+
+        template<typename T>
+        class AsyncEvent;
+
+        /// \brief      An event whose listeners are called on an Executor rather than on the thread calling Fire(),
+        ///             so that a busy producer does not pay for slow listeners.
+        /// \details    Fire() copies (or moves) the parameters into a queue and returns. The first fire into an empty
+        ///             queue gives the executor a task which delivers everything in the queue (including fires
+        ///             made while it runs), so a producer which fires faster than the listeners run only pays for
+        ///             the queue push. Only one delivery task per event runs at a time, so the listeners of one
+        ///             event are never called concurrently, and fires are delivered in order, even on a
+        ///             ThreadPoolExecutor with several threads.
+        ///             With a CoalescePolicy other than None, the queue holds at most one fire, and further fires
+        ///             replace it (LastValueWins) or are merged into it (Accumulate) until it is delivered.
+        ///             Listeners can be added and removed from any thread, see ConcurrentEvent.
+        ///             The destructor waits for queued fires to be delivered. This class is neither movable nor
+        ///             copyable.
+        template<typename ...Args>
+        class AsyncEvent<void(Args...)> {
+
+            using FuncType = void(Args...);
+
+        public:
+
+            /// \brief      The parameters of a fire, as kept in the queue.
+            using Parameters = std::tuple<typename std::decay<Args>::type...>;
+
+            /// \brief      Merges the parameters of a new fire (incoming) into the fire waiting to be delivered
+            ///             (pending), for CoalescePolicy::Accumulate.
+            using Accumulator = std::function<void(Parameters& pending, Parameters&& incoming)>;
+
+            /// \throws     std::invalid_argument if executor is null, or if policy is CoalescePolicy::Accumulate (use
+            ///             the constructor taking an Accumulator instead).
+            AsyncEvent(std::shared_ptr<Executor> executor, CoalescePolicy policy = CoalescePolicy::None) :
+                    executor_(std::move(executor)),
+                    policy_(policy) {
+                if(!executor_)
+                    throw std::invalid_argument(std::string() + "executor provided to " + __PRETTY_FUNCTION__ +
+                                                " was null.");
+                if(policy_ == CoalescePolicy::Accumulate)
+                    throw std::invalid_argument(std::string() + "CoalescePolicy::Accumulate provided to " +
+                                                __PRETTY_FUNCTION__ + " without an accumulator.");
+            }
+
+            /// \brief      Creates an event with CoalescePolicy::Accumulate.
+            /// \throws     std::invalid_argument if executor is null or accumulator does not have a valid object
+            ///             to call.
+            AsyncEvent(std::shared_ptr<Executor> executor, Accumulator accumulator) :
+                    executor_(std::move(executor)),
+                    policy_(CoalescePolicy::Accumulate),
+                    accumulator_(std::move(accumulator)) {
+                if(!executor_)
+                    throw std::invalid_argument(std::string() + "executor provided to " + __PRETTY_FUNCTION__ +
+                                                " was null.");
+                if(!accumulator_)
+                    throw std::invalid_argument(std::string() + "accumulator provided to " + __PRETTY_FUNCTION__ +
+                                                " does not have a valid object to call.");
+            }
+
+            AsyncEvent(const AsyncEvent&) = delete;
+            AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+            /// \brief      Waits for all queued fires to be delivered.
+            ~AsyncEvent() {
+                Flush();
+            }
+
+            /// \brief      Attach a listener to this event. Will be called on the executor after Fire() is called.
+            /// \returns    An ID for the listener, which can be given to RemoveListener().
+            /// \note       Thread-safe.
+            ListenerId AddListener(std::function<FuncType> listener) {
+                return listeners_.AddListener(std::move(listener));
+            }
+
+            /// \brief      Attach a listener to this event, which is removed again when the returned Subscription
+            ///             is destroyed.
+            /// \note       Thread-safe.
+            /// \warning    The event must outlive the Subscription.
+            Subscription Subscribe(std::function<FuncType> listener) {
+                return Subscription(*this, AddListener(std::move(listener)));
+            }
+
+            /// \brief      Detaches a listener. See ConcurrentEvent::RemoveListener().
+            /// \note       Thread-safe.
+            bool RemoveListener(ListenerId listenerId) {
+                return listeners_.RemoveListener(listenerId);
+            }
+
+            /// \brief      Remove all listeners attached to this event.
+            /// \note       Thread-safe.
+            void RemoveAllListeners() {
+                listeners_.RemoveAllListeners();
+            }
+
+            /// \brief      Queues a fire to be delivered to the listeners on the executor, and returns straight away.
+            /// \details    The parameters are copied (or moved, if given as rvalues) into the queue. Listeners
+            ///             taking parameters by reference get a reference to the queued copy.
+            /// \note       Thread-safe and re-entrant, and can be called from inside a listener.
+            template <class ...Arg>
+            void Fire(Arg&&... parameters) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                numFires_++;
+                if(queue_.empty() || policy_ == CoalescePolicy::None)
+                    queue_.emplace_back(std::forward<Arg>(parameters)...);
+                else if(policy_ == CoalescePolicy::LastValueWins)
+                    queue_.back() = Parameters(std::forward<Arg>(parameters)...);
+                else
+                    accumulator_(queue_.back(), Parameters(std::forward<Arg>(parameters)...));
+
+                if(isDispatching_)
+                    return;
+                isDispatching_ = true;
+                lock.unlock();
+                executor_->Execute([this]() {
+                    Dispatch();
+                });
+            }
+
+            /// \brief      Blocks until every fire queued so far (and any made meanwhile) has been delivered.
+            /// \warning    Do not call from inside a listener of this event, as it would wait for itself.
+            void Flush() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                idle_.wait(lock, [&]() {
+                    return !isDispatching_;
+                });
+            }
+
+            /// \returns    The number of times Fire() has been called.
+            /// \note       Thread-safe and re-entrant.
+            uint64_t GetNumFires() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return numFires_;
+            }
+
+            /// \returns    The number of fires which have been taken from the queue to be delivered. With a
+            ///             CoalescePolicy, this is less than GetNumFires() by the number of fires which were
+            ///             coalesced. Call Flush() first to include every fire.
+            /// \note       Thread-safe and re-entrant.
+            uint64_t GetNumDeliveries() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return numDeliveries_;
+            }
+
+        private:
+
+            /// \brief      Runs on the executor, delivering fires until the queue is empty.
+            void Dispatch() {
+                while(true) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if(queue_.empty()) {
+                            isDispatching_ = false;
+                            // Notified under the lock, as Flush() returning may destroy this event
+                            idle_.notify_all();
+                            return;
+                        }
+                        // Swapped rather than copied, so both vectors keep their capacity and steady state
+                        // delivery does not allocate
+                        std::swap(queue_, delivering_);
+                        numDeliveries_ += delivering_.size();
+                    }
+
+                    for(auto& parameters : delivering_)
+                        Deliver(parameters, std::index_sequence_for<Args...>());
+                    delivering_.clear();
+                }
+            }
+
+            template<std::size_t ...I>
+            void Deliver(Parameters& parameters, std::index_sequence<I...>) {
+                listeners_.Fire(std::get<I>(std::move(parameters))...);
+            }
+
+            std::shared_ptr<Executor> executor_;
+            CoalescePolicy policy_;
+            Accumulator accumulator_;
+
+            ConcurrentEvent<FuncType> listeners_;
+
+            std::mutex mutex_;
+            std::condition_variable idle_;
+
+            /// \brief      Fires waiting to be delivered.
+            std::vector<Parameters> queue_;
+
+            /// \brief      Fires being delivered, only touched by Dispatch().
+            std::vector<Parameters> delivering_;
+
+            /// \brief      True while a Dispatch() task has been given to the executor and has not finished.
+            bool isDispatching_ = false;
+
+            uint64_t numFires_ = 0;
+            uint64_t numDeliveries_ = 0;
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_ASYNC_EVENT_H_
@@ -0,0 +1,265 @@
+///
+/// \file 				ConcurrentEvent.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the ConcurrentEvent class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_CONCURRENT_EVENT_H_
+#define MN_CPP_UTILS_CONCURRENT_EVENT_H_
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// User includes
+#include "Event.hpp"
+#include "Subscription.hpp"
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      A thread-safe version of Event, where listeners can be added and removed from any thread while
+        ///             other threads are firing it.
+        /// \details    The listeners are kept in an immutable list which is replaced (copy-on-write) whenever a
+        ///             listener is added or removed, read-copy-update style. Fire() never takes a lock, it marks
+        ///             itself as a reader under the current epoch with one atomic increment, calls the listeners, and
+        ///             unmarks itself, so it is wait-free and never blocked by a writer. Writers are serialised by a
+        ///             mutex (which Fire() never touches) and publish the new list with an atomic exchange. They then
+        ///             release the mutex and wait out a grace period (the reader count of each epoch being seen at 0,
+        ///             one after the other) before freeing the old list. Writers wait one at a time, so they never
+        ///             send new readers to an epoch another writer is waiting on. A writer called from inside a
+        ///             listener does not wait (as it would be waiting for itself), the old list is freed by a later
+        ///             writer instead.
+        ///             A fire which starts while a listener is being added or removed calls either the old or the
+        ///             new listeners, never a mix.
+        ///             This class is neither movable nor copyable. Do not destroy it while it is being fired.
+        template<typename T>
+        class ConcurrentEvent {
+
+            using FuncType = T;
+
+        public:
+
+            ConcurrentEvent() : listeners_(new Listeners()) {}
+
+            ConcurrentEvent(const ConcurrentEvent&) = delete;
+            ConcurrentEvent& operator=(const ConcurrentEvent&) = delete;
+
+            ~ConcurrentEvent() {
+                delete listeners_.load(std::memory_order_relaxed);
+                for(auto& retired : retired_)
+                    delete retired.listeners_;
+            }
+
+            /// \brief      Attach a listener to this event. Will be called when ConcurrentEvent::Fire() is called.
+            /// \returns    An ID for the listener, which can be given to RemoveListener().
+            /// \note       Thread-safe. Never blocks a concurrent Fire(), but waits for fires that started before the
+            ///             listener was added to finish.
+            ListenerId AddListener(std::function<FuncType> listener) {
+                std::unique_lock<std::mutex> lock(writeMutex_);
+                auto newListeners = new Listeners(*listeners_.load(std::memory_order_relaxed));
+                auto id = ListenerId(nextId_++);
+                newListeners->push_back(std::make_pair(id, std::move(listener)));
+                Publish(newListeners, lock);
+                return id;
+            }
+
+            /// \brief      Attach a listener to this event, which is removed again when the returned Subscription
+            ///             is destroyed (or Subscription::Unsubscribe() is called).
+            /// \note       Thread-safe, see AddListener() and RemoveListener().
+            /// \warning    The event must outlive the Subscription.
+            Subscription Subscribe(std::function<FuncType> listener) {
+                return Subscription(*this, AddListener(std::move(listener)));
+            }
+
+            /// \brief      Detaches a listener. Once this returns, the listener will not be called by any fire that
+            ///             starts afterwards (or, unless called from inside a listener, by any fire at all).
+            /// \returns    True if the listener was found and removed, otherwise false.
+            /// \note       Thread-safe, and can be called from inside a listener (including the one being removed).
+            bool RemoveListener(ListenerId id) {
+                std::unique_lock<std::mutex> lock(writeMutex_);
+                auto& listeners = *listeners_.load(std::memory_order_relaxed);
+                auto it = std::find_if(listeners.begin(), listeners.end(), [&](const Listener& listener) {
+                    return listener.first == id;
+                });
+                if(it == listeners.end())
+                    return false;
+
+                auto newListeners = new Listeners();
+                newListeners->reserve(listeners.size() - 1);
+                newListeners->insert(newListeners->end(), listeners.begin(), it);
+                newListeners->insert(newListeners->end(), it + 1, listeners.end());
+                Publish(newListeners, lock);
+                return true;
+            }
+
+            /// \brief      Remove all listeners attached to this event.
+            /// \note       Thread-safe, see RemoveListener().
+            void RemoveAllListeners() {
+                std::unique_lock<std::mutex> lock(writeMutex_);
+                Publish(new Listeners(), lock);
+            }
+
+            /// \returns    The number of listeners attached.
+            /// \note       Thread-safe and re-entrant.
+            std::size_t GetNumListeners() {
+                ReadGuard guard(*this);
+                return guard.listeners_->size();
+            }
+
+            /// \brief      Calls every listener, in the order they were added, with the given parameters. See
+            ///             Event::Fire().
+            /// \note       Thread-safe, re-entrant, wait-free and does not allocate.
+            template <class ...Arg>
+            void Fire(Arg&&... parameters) {
+                ReadGuard guard(*this);
+                auto& listeners = *guard.listeners_;
+                if(listeners.empty())
+                    return;
+                auto last = listeners.size() - 1;
+                for(std::size_t i = 0; i < last; i++)
+                    CallListener(listeners[i].second, std::forward<Arg>(parameters)...);
+                CallLastListener(listeners[last].second, std::forward<Arg>(parameters)...);
+            }
+
+        private:
+
+            using Listener = std::pair<ListenerId, std::function<FuncType>>;
+            using Listeners = std::vector<Listener>;
+
+            /// \brief      A list which has been replaced, but may still be in use by a fire which started before it
+            ///             was replaced.
+            struct Retired {
+                Listeners* listeners_;
+
+                /// \brief      The order the list was replaced in.
+                uint64_t sequence_;
+
+                /// \brief      Bit n is set once numReaders_[n] has been seen at 0 since the list was replaced. Any
+                ///             fire using the list was counted (under one epoch or the other) before it was replaced,
+                ///             so once both bits are set no fire can still be using it.
+                uint32_t drainedEpochs_;
+            };
+
+            /// \brief      Marks the calling thread as a reader of the current list for it's lifetime.
+            /// \details    The reader is counted against the current epoch before loading the list. A reader which
+            ///             loaded the epoch just before a writer flipped it is still counted under the old epoch,
+            ///             which is why a writer waits for both epochs to drain, not just the one it flipped away from.
+            class ReadGuard {
+            public:
+                ReadGuard(ConcurrentEvent& event) : event_(event) {
+                    epoch_ = event_.epoch_.load(std::memory_order_seq_cst);
+                    event_.numReaders_[epoch_].fetch_add(1, std::memory_order_seq_cst);
+                    listeners_ = event_.listeners_.load(std::memory_order_seq_cst);
+                    GetFireDepth()++;
+                }
+
+                ~ReadGuard() {
+                    GetFireDepth()--;
+                    event_.numReaders_[epoch_].fetch_sub(1, std::memory_order_release);
+                }
+
+                ConcurrentEvent& event_;
+                uint32_t epoch_;
+                const Listeners* listeners_;
+            };
+
+            /// \returns    The number of Fire() calls in progress on the calling thread (on any ConcurrentEvent of
+            ///             this type), used to tell when a writer is being called from inside a listener.
+            static int& GetFireDepth() {
+                static thread_local int fireDepth = 0;
+                return fireDepth;
+            }
+
+            /// \brief      Publishes a new list of listeners, waits for the fires which may still be using the old
+            ///             one to finish (unless called from inside a listener), and frees every replaced list which
+            ///             is no longer in use.
+            /// \param      lock    Must hold writeMutex_. It is released while waiting, as a fire being waited for
+            ///                     may itself be blocked on writeMutex_ from inside a listener.
+            void Publish(Listeners* newListeners, std::unique_lock<std::mutex>& lock) {
+                auto oldListeners = listeners_.exchange(newListeners, std::memory_order_seq_cst);
+                auto sequence = nextSequence_++;
+                retired_.push_back(Retired{ oldListeners, sequence, 0 });
+
+                // Inside a listener the calling thread is counted as a reader itself, so waiting would never end.
+                // Flip the epoch so the current one can drain, and leave the list for a later writer to free. The
+                // epoch is left alone while another writer is waiting out a grace period, as flipping it could send
+                // new readers to the epoch that writer is waiting on
+                if(GetFireDepth() != 0) {
+                    if(graceMutex_.try_lock()) {
+                        epoch_.store(epoch_.load(std::memory_order_relaxed) ^ 1, std::memory_order_seq_cst);
+                        graceMutex_.unlock();
+                    }
+                    FreeDrained();
+                    return;
+                }
+
+                // Wait for each epoch to drain in turn, first sending new readers to the other epoch so the count
+                // being waited on can only fall. Only one writer waits at a time, so no other writer can flip the
+                // epoch back meanwhile
+                lock.unlock();
+                {
+                    std::lock_guard<std::mutex> graceLock(graceMutex_);
+                    for(uint32_t epoch = 0; epoch < 2; epoch++) {
+                        epoch_.store(epoch ^ 1, std::memory_order_seq_cst);
+                        while(numReaders_[epoch].load(std::memory_order_seq_cst) != 0)
+                            std::this_thread::yield();
+                    }
+                }
+                lock.lock();
+
+                // Both epochs have been seen at 0 since every list up to this one was replaced
+                for(auto& retired : retired_) {
+                    if(retired.sequence_ <= sequence)
+                        retired.drainedEpochs_ = 3;
+                }
+                FreeDrained();
+            }
+
+            /// \brief      Records which epochs have no readers right now, and frees the replaced lists which have
+            ///             seen both epochs drain.
+            /// \warning    writeMutex_ must be held.
+            void FreeDrained() {
+                for(uint32_t epoch = 0; epoch < 2; epoch++) {
+                    if(numReaders_[epoch].load(std::memory_order_seq_cst) != 0)
+                        continue;
+                    for(auto& retired : retired_)
+                        retired.drainedEpochs_ |= 1u << epoch;
+                }
+                retired_.erase(std::remove_if(retired_.begin(), retired_.end(), [&](const Retired& retired) {
+                    if(retired.drainedEpochs_ != 3)
+                        return false;
+                    delete retired.listeners_;
+                    return true;
+                }), retired_.end());
+            }
+
+            std::atomic<Listeners*> listeners_;
+            std::atomic<uint32_t> epoch_{0};
+            std::atomic<uint32_t> numReaders_[2] = {{0}, {0}};
+
+            /// \brief      Serialises writers. Never taken by Fire().
+            std::mutex writeMutex_;
+
+            /// \brief      Held by a writer while it waits out a grace period, so only one writer flips the epoch at a
+            ///             time. Never taken by Fire(), and never waited for from inside a listener.
+            std::mutex graceMutex_;
+            std::vector<Retired> retired_;
+            uint64_t nextSequence_ = 0;
+            uint64_t nextId_ = 0;
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_CONCURRENT_EVENT_H_
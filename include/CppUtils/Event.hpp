@@ -3,8 +3,8 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-07-25
-/// \last-modified		2017-08-14
-/// \brief 				Contains the Event class.
+/// \last-modified		2026-10-17
+/// \brief 				Contains the Event class, and the CallListener() functions used by all the event classes.
 /// \details
 ///		See README.md in root dir for more info.
 
@@ -12,12 +12,74 @@
 #define MN_CPP_UTILS_EVENT_H_
 
 // System includes
+#include <cstdint>
 #include <string>
 #include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// User includes
+#include "Subscription.hpp"
 
 namespace mn {
     namespace CppUtils {
 
+        /// \brief      True if Listener can be called with the parameters Arg... (as given to std::forward()).
+        template<typename Listener, typename ...Arg>
+        class IsListenerCallable {
+            template<typename L>
+            static auto Test(int) -> decltype((void)std::declval<L&>()(std::declval<Arg>()...), std::true_type());
+
+            template<typename L>
+            static std::false_type Test(...);
+
+        public:
+            static constexpr bool value = decltype(Test<Listener>(0))::value;
+        };
+
+        /// \brief      Calls one of several listeners of a fire, without letting it move out of the parameters the
+        ///             listeners after it still need.
+        /// \details    The parameters are given to the listener as lvalues, so a listener taking a parameter by value
+        ///             gets it's own copy, and one taking it by reference gets a reference to the caller's object. A
+        ///             listener which can't take lvalues (e.g. one taking std::string&&) gets a copy of every
+        ///             parameter instead.
+        template<typename Listener, typename ...Arg>
+        void CallListener(std::true_type /* isCallableWithLvalues */, Listener& listener, Arg&&... parameters) {
+            listener(parameters...);
+        }
+
+        template<typename Listener, typename ...Arg>
+        void CallListener(std::false_type /* isCallableWithLvalues */, Listener& listener, Arg&&... parameters) {
+            listener(typename std::decay<Arg>::type(parameters)...);
+        }
+
+        template<typename Listener, typename ...Arg>
+        void CallListener(Listener& listener, Arg&&... parameters) {
+            CallListener(std::integral_constant<bool, IsListenerCallable<Listener, Arg&...>::value>(), listener,
+                         std::forward<Arg>(parameters)...);
+        }
+
+        /// \brief      Calls the last listener of a fire, which is given the parameters forwarded, as nothing is
+        ///             called after it. A listener which can't take them as given (e.g. one taking std::string&& when
+        ///             fired with an lvalue) gets a copy of every parameter instead.
+        template<typename Listener, typename ...Arg>
+        void CallLastListener(std::true_type /* isCallable */, Listener& listener, Arg&&... parameters) {
+            listener(std::forward<Arg>(parameters)...);
+        }
+
+        template<typename Listener, typename ...Arg>
+        void CallLastListener(std::false_type /* isCallable */, Listener& listener, Arg&&... parameters) {
+            listener(typename std::decay<Arg>::type(parameters)...);
+        }
+
+        template<typename Listener, typename ...Arg>
+        void CallLastListener(Listener& listener, Arg&&... parameters) {
+            CallLastListener(std::integral_constant<bool, IsListenerCallable<Listener, Arg&&...>::value>(), listener,
+                             std::forward<Arg>(parameters)...);
+        }
+
         template<typename T>
         class Event {
 
@@ -26,36 +88,137 @@ namespace mn {
         public:
 
             /// \brief      Attach a listener to this event. Will be called when Event::Fire() is called.
-            void AddListener(std::function<FuncType> listener) {
-                listeners_.push_back(listener);
+            /// \returns    An ID for the listener, which can be given to RemoveListener(). Can be ignored if the
+            ///             listener is never removed on it's own.
+            ListenerId AddListener(std::function<FuncType> listener) {
+                uint32_t slotIndex;
+                if(freeSlots_.empty()) {
+                    slotIndex = static_cast<uint32_t>(slots_.size());
+                    slots_.push_back(Slot());
+                } else {
+                    slotIndex = freeSlots_.back();
+                    freeSlots_.pop_back();
+                }
+                slots_[slotIndex].listenerIndex_ = static_cast<uint32_t>(listeners_.size());
+                listeners_.push_back(std::move(listener));
+                listenerSlots_.push_back(slotIndex);
+                return ListenerId((static_cast<uint64_t>(slots_[slotIndex].generation_) << 32) | slotIndex);
             };
 
+            /// \brief      Attach a listener to this event, which is removed again when the returned Subscription
+            ///             is destroyed (or Subscription::Unsubscribe() is called).
+            /// \warning    The event must outlive the Subscription.
+            Subscription Subscribe(std::function<FuncType> listener) {
+                return Subscription(*this, AddListener(std::move(listener)));
+            }
+
+            /// \brief      Detaches the listener with the given ID, in O(1) time.
+            /// \returns    True if the listener was found and removed, false if it had already been removed.
+            bool RemoveListener(ListenerId listenerId) {
+                auto slotIndex = static_cast<uint32_t>(listenerId.GetValue());
+                auto generation = static_cast<uint32_t>(listenerId.GetValue() >> 32);
+                if(slotIndex >= slots_.size() || slots_[slotIndex].generation_ != generation)
+                    return false;
+                RemoveAt(slots_[slotIndex].listenerIndex_);
+                return true;
+            }
+
+            /// \brief      Detaches the listener at the given position in the list of listeners (which is the order
+            ///             they are called in, see Fire()).
+            ///             The listeners after it keep their order, and move down one position.
+            /// \deprecated Positions change as listeners are removed, use RemoveListener(ListenerId) instead.
             void RemoveListener(uint32_t index) {
 
                 if(index >= listeners_.size())
                     throw std::invalid_argument("RemoveListener() called with index >= size of listeners_ array.");
 
-                listeners_.erase(listeners_.begin() + index);
+                EraseAt(index);
             }
 
             /// \brief      Remove all listeners attached to this event.
             void RemoveAllListeners() {
-                listeners_.clear();
+                while(!listeners_.empty())
+                    RemoveAt(static_cast<uint32_t>(listeners_.size() - 1));
+            }
+
+            /// \returns    The number of listeners attached.
+            std::size_t GetNumListeners() const {
+                return listeners_.size();
             }
 
+            /// \brief      Calls every listener with the given parameters. Listeners are called in the order they
+            ///             were added, except that removing a listener by ListenerId moves the last listener into
+            ///             it's place.
+            /// \details    The listeners are called in place (nothing is copied or allocated per fire), and the
+            ///             parameters are passed to every listener as lvalues, so a listener taking a parameter by
+            ///             value gets it's own copy and cannot leave a moved-from value for the next listener. Only
+            ///             the last listener gets the parameters forwarded, as nothing is called after it. Listeners
+            ///             taking rvalue references get their own copy of the parameters, see CallListener().
+            /// \warning    Do not add or remove listeners from within a listener.
             template <class ...Arg>
-            void Fire(Arg... parameters) {
-                for(auto listener : listeners_) {
-                    // Perfect forward the parameters to the listener
-                    listener(std::forward<Arg>(parameters)...);
-                }
+            void Fire(Arg&&... parameters) {
+                if(listeners_.empty())
+                    return;
+                auto last = listeners_.size() - 1;
+                for(std::size_t i = 0; i < last; i++)
+                    CallListener(listeners_[i], std::forward<Arg>(parameters)...);
+                CallLastListener(listeners_[last], std::forward<Arg>(parameters)...);
             }
 
         private:
 
-            /// \brief      Keeps track of all the attached listeners.
+            /// \brief      Maps a ListenerId to the listener's current position in listeners_. The generation is
+            ///             incremented each time the slot is freed, so IDs of removed listeners never match a
+            ///             listener which later reuses the slot.
+            struct Slot {
+                uint32_t listenerIndex_ = 0;
+                uint32_t generation_ = 0;
+            };
+
+            /// \brief      Removes the listener at index by moving the last listener into it's place (swap-and-pop),
+            ///             so listeners_ stays contiguous without shifting every listener after it.
+            void RemoveAt(uint32_t index) {
+                auto slotIndex = listenerSlots_[index];
+                auto last = static_cast<uint32_t>(listeners_.size() - 1);
+                if(index != last) {
+                    listeners_[index] = std::move(listeners_[last]);
+                    listenerSlots_[index] = listenerSlots_[last];
+                    slots_[listenerSlots_[index]].listenerIndex_ = index;
+                }
+                listeners_.pop_back();
+                listenerSlots_.pop_back();
+
+                FreeSlot(slotIndex);
+            }
+
+            /// \brief      Removes the listener at index by shifting every listener after it down one position, so
+            ///             the order of the remaining listeners is kept.
+            void EraseAt(uint32_t index) {
+                auto slotIndex = listenerSlots_[index];
+                listeners_.erase(listeners_.begin() + index);
+                listenerSlots_.erase(listenerSlots_.begin() + index);
+                for(auto i = index; i < listenerSlots_.size(); i++)
+                    slots_[listenerSlots_[i]].listenerIndex_ = i;
+
+                FreeSlot(slotIndex);
+            }
+
+            /// \brief      Frees the slot of a removed listener, so it's ID no longer matches.
+            void FreeSlot(uint32_t slotIndex) {
+                slots_[slotIndex].generation_++;
+                freeSlots_.push_back(slotIndex);
+            }
+
+            /// \brief      Keeps track of all the attached listeners, contiguously so Fire() is a straight walk.
             std::vector<std::function<T>> listeners_;
 
+            /// \brief      The slot of each listener in listeners_ (at the same position), to update the slot when
+            ///             the listener is moved.
+            std::vector<uint32_t> listenerSlots_;
+
+            std::vector<Slot> slots_;
+            std::vector<uint32_t> freeSlots_;
+
         };
     } // namespace CppUtils
 } // namespace mn
@@ -0,0 +1,110 @@
+///
+/// \file 				Executor.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the Executor and ThreadPoolExecutor classes.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_EXECUTOR_H_
+#define MN_CPP_UTILS_EXECUTOR_H_
+
+// System includes
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// User includes
+#include "ThreadSafeQueue.hpp"
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      Abstract base class for something that can run tasks, e.g. a pool of worker threads or a
+        ///             user supplied dispatcher.
+        class Executor {
+        public:
+
+            virtual ~Executor() {}
+
+            /// \brief      Called to run a task. The task may be run at some later time, and in the context of
+            ///             a different thread.
+            /// \note       Implementations must be thread-safe.
+            virtual void Execute(std::function<void()> task) = 0;
+        };
+
+        /// \brief      An executor which runs tasks on a fixed size pool of worker threads.
+        /// \details    Tasks are run in the order they were given to Execute(), although with more than one worker
+        ///             thread two tasks may run at the same time. On destruction, all tasks that have already been
+        ///             given to Execute() are run before the worker threads are joined.
+        ///             This class is neither movable nor copyable.
+        class ThreadPoolExecutor : public Executor {
+        public:
+
+            /// \brief      Creates the pool and starts the worker threads.
+            /// \param[in]  numThreads  The number of worker threads. Defaults to the number of hardware threads.
+            /// \throws     std::invalid_argument if numThreads is 0.
+            ThreadPoolExecutor(std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency())) {
+                if(numThreads == 0)
+                    throw std::invalid_argument(std::string() + "numThreads provided to " + __PRETTY_FUNCTION__ +
+                                                " was 0.");
+
+                for(std::size_t i = 0; i < numThreads; i++)
+                    threads_.push_back(std::thread(&ThreadPoolExecutor::Process, this));
+            }
+
+            ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+            ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+            /// \brief      Runs all remaining tasks, and then stops and joins with the worker threads.
+            ~ThreadPoolExecutor() {
+                // An empty task tells a worker thread to exit. Since the queue is FIFO, these will only be popped
+                // once all the real tasks have been
+                for(std::size_t i = 0; i < threads_.size(); i++)
+                    queue_.Push(std::function<void()>());
+
+                for(auto& thread : threads_)
+                    thread.join();
+            }
+
+            /// \brief      Queues the task to be run on one of the worker threads.
+            /// \throws     std::invalid_argument if task does not have a valid object to call.
+            /// \note       Thread-safe and re-entrant.
+            void Execute(std::function<void()> task) override {
+                if(!task)
+                    throw std::invalid_argument(std::string() + "task provided to " + __PRETTY_FUNCTION__ +
+                                                " does not have a valid object to call.");
+                queue_.Push(task);
+            }
+
+            /// \returns    The number of worker threads in the pool.
+            std::size_t GetNumThreads() const {
+                return threads_.size();
+            }
+
+        private:
+
+            /// \brief      Function for the worker threads.
+            void Process() {
+                std::function<void()> task;
+                while(true) {
+                    queue_.Pop(task);
+                    if(!task)
+                        return;
+                    task();
+                }
+            }
+
+            ThreadSafeQueue<std::function<void()>> queue_;
+            std::vector<std::thread> threads_;
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_EXECUTOR_H_
@@ -0,0 +1,129 @@
+///
+/// \file 				Futex.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the Futex class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_FUTEX_H_
+#define MN_CPP_UTILS_FUTEX_H_
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#endif
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      Lets threads sleep until the value of a 32-bit atomic changes, without the atomic needing a
+        ///             mutex or condition variable of it's own.
+        /// \details    On Linux this is a thin wrapper around the futex system call, the kernel keeps the queue of
+        ///             waiting threads. Elsewhere, the waiting threads are kept in a small fixed table of condition
+        ///             variables, hashed by the address of the atomic.
+        ///             Wait() can return spuriously, so always re-check the value in a loop. Only call Wake() if a
+        ///             thread may be waiting (e.g. keep a count of waiters next to the atomic), so that the common
+        ///             case makes no system call at all.
+        class Futex {
+        public:
+
+            /// \brief      Blocks until woken by Wake(), but only if the atomic still holds expected (this check and
+            ///             going to sleep are atomic with respect to Wake()). May return spuriously.
+            /// \note       Thread-safe and re-entrant.
+            static void Wait(std::atomic<uint32_t>& word, uint32_t expected) {
+#ifdef __linux__
+                syscall(SYS_futex, Address(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+                auto& bucket = GetBucket(word);
+                std::unique_lock<std::mutex> lock(bucket.mutex_);
+                if(word.load(std::memory_order_relaxed) == expected)
+                    bucket.cv_.wait(lock);
+#endif
+            }
+
+            /// \brief      Same as Wait(), but gives up after the timeout.
+            /// \returns    False if the timeout occurred, otherwise true (which does not mean the value has changed).
+            /// \note       Thread-safe and re-entrant.
+            static bool WaitFor(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) {
+                if(timeout.count() <= 0)
+                    return false;
+#ifdef __linux__
+                timespec spec = {};
+                spec.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+                spec.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+                if(syscall(SYS_futex, Address(word), FUTEX_WAIT_PRIVATE, expected, &spec, nullptr, 0) < 0)
+                    return errno != ETIMEDOUT;
+                return true;
+#else
+                auto& bucket = GetBucket(word);
+                std::unique_lock<std::mutex> lock(bucket.mutex_);
+                if(word.load(std::memory_order_relaxed) != expected)
+                    return true;
+                return bucket.cv_.wait_for(lock, timeout) == std::cv_status::no_timeout;
+#endif
+            }
+
+            /// \brief      Wakes up to numWaiters threads blocked in Wait() or WaitFor() on the atomic.
+            /// \note       Thread-safe and re-entrant.
+            static void Wake(std::atomic<uint32_t>& word, int numWaiters = 1) {
+#ifdef __linux__
+                syscall(SYS_futex, Address(word), FUTEX_WAKE_PRIVATE, numWaiters, nullptr, nullptr, 0);
+#else
+                // Other atomics can share the bucket, so wake everyone and let the spurious ones go back to sleep
+                (void)numWaiters;
+                auto& bucket = GetBucket(word);
+                { std::lock_guard<std::mutex> lock(bucket.mutex_); }
+                bucket.cv_.notify_all();
+#endif
+            }
+
+            /// \brief      Wakes all threads blocked in Wait() or WaitFor() on the atomic.
+            /// \note       Thread-safe and re-entrant.
+            static void WakeAll(std::atomic<uint32_t>& word) {
+                Wake(word, INT_MAX);
+            }
+
+        private:
+
+#ifdef __linux__
+            static uint32_t* Address(std::atomic<uint32_t>& word) {
+                static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                              "std::atomic<uint32_t> must have the same layout as uint32_t to be used as a futex.");
+                return reinterpret_cast<uint32_t*>(&word);
+            }
+#else
+            struct Bucket {
+                std::mutex mutex_;
+                std::condition_variable cv_;
+            };
+
+            static constexpr std::size_t NUM_BUCKETS = 64;
+
+            static Bucket& GetBucket(std::atomic<uint32_t>& word) {
+                static Bucket buckets[NUM_BUCKETS];
+                return buckets[std::hash<void*>()(&word) % NUM_BUCKETS];
+            }
+#endif
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_FUTEX_H_
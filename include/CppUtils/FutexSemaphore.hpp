@@ -0,0 +1,204 @@
+///
+/// \file 				FutexSemaphore.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the FutexSemaphore class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_FUTEX_SEMAPHORE_H_
+#define MN_CPP_UTILS_FUTEX_SEMAPHORE_H_
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+// User includes
+#include "Futex.hpp"
+#include "WaitSet.hpp"
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      A counting semaphore with the same interface as Semaphore, which only makes a system call when
+        ///             a thread really has to sleep or be woken.
+        /// \details    The count is a single atomic. Notify() increments it, and only calls into the kernel if a
+        ///             thread is parked. Wait() takes the count with a compare-and-swap if it is positive, otherwise
+        ///             spins for a while (in case it is about to be notified), and only then parks on a futex.
+        ///             The spin limit adapts: it doubles when spinning pays off and halves when the thread had to park
+        ///             anyway, between MIN_SPINS and MAX_SPINS. On a single CPU machine spinning can only delay the
+        ///             thread that would notify, so Wait() parks straight away.
+        ///             This class is neither movable nor copyable.
+        class FutexSemaphore : public Waitable {
+        public:
+
+            static constexpr uint32_t MIN_SPINS = 16;
+            static constexpr uint32_t MAX_SPINS = 4096;
+
+            FutexSemaphore() {}
+
+            FutexSemaphore(const FutexSemaphore&) = delete;
+            FutexSemaphore& operator=(const FutexSemaphore&) = delete;
+
+            /// \brief      Increments the count by count (one atomic operation, rather than count calls to Notify()),
+            ///             and wakes up as many parked threads as the new permits can satisfy.
+            /// \note       Thread-safe and re-entrant. Makes no system call if no thread is parked.
+            void Notify(uint32_t count = 1) {
+                if(count == 0)
+                    return;
+                // Checked before the permits are given, as a thread taking them may destroy the semaphore straight
+                // away (which is why sources must be added to a WaitSet before they are notified)
+                auto hasWaitSets = HasWaitSets();
+                count_.fetch_add(count, std::memory_order_seq_cst);
+                if(numWaiters_.load(std::memory_order_seq_cst) != 0) {
+                    // A thread waiting for several permits may not be satisfied by the ones given to it, and would
+                    // then go back to sleep while another parked thread could have been, so in that case wake them all
+                    if(numMultiWaiters_.load(std::memory_order_relaxed) != 0)
+                        Futex::WakeAll(count_);
+                    else
+                        Futex::Wake(count_, count > INT_MAX ? INT_MAX : static_cast<int>(count));
+                }
+                if(hasWaitSets)
+                    NotifyWaitSets();
+            }
+
+            /// \brief      Blocks indefinitely until Notify() is called.
+            /// \note       Thread-safe and re-entrant. Makes no system call if the count is already positive.
+            void Wait() {
+                Wait(1);
+            }
+
+            /// \brief      Blocks indefinitely until count permits are available, and takes them all at once.
+            /// \details    Permits are never handed out piecemeal, so a thread waiting for several permits only
+            ///             takes them once they are all available at the same time.
+            /// \note       Thread-safe and re-entrant. Makes no system call if enough permits are already available.
+            void Wait(uint32_t count) {
+                if(TryAcquire(count) || Spin(count))
+                    return;
+
+                AddWaiter(count);
+                uint32_t available;
+                while(!TryAcquire(count, available))
+                    Futex::Wait(count_, available);
+                RemoveWaiter(count);
+            }
+
+            /// \brief      Blocks until either Notify() is called, or a timeout occurs.
+            /// \returns    Returns true if Notify() was called before timeout occurred, otherwise false.
+            /// \note       Thread-safe and re-entrant.
+            bool TryWait(std::chrono::milliseconds timeout) {
+                return TryWait(1, timeout);
+            }
+
+            /// \brief      Blocks until either count permits are available (and takes them all at once), or a timeout
+            ///             occurs.
+            /// \returns    Returns true if the permits were taken before timeout occurred, otherwise false (in which
+            ///             case none are taken).
+            /// \note       Thread-safe and re-entrant.
+            bool TryWait(uint32_t count, std::chrono::milliseconds timeout) {
+                if(TryAcquire(count) || Spin(count))
+                    return true;
+
+                auto deadline = std::chrono::steady_clock::now() + timeout;
+                bool acquired;
+                uint32_t available;
+                AddWaiter(count);
+                while(!(acquired = TryAcquire(count, available))) {
+                    if(!Futex::WaitFor(count_, available, deadline - std::chrono::steady_clock::now())) {
+                        // We may have been notified right as the timeout occurred
+                        acquired = TryAcquire(count);
+                        break;
+                    }
+                }
+                RemoveWaiter(count);
+                return acquired;
+            }
+
+            /// \returns    True if Wait() would not block right now (i.e. the count is positive). Used by WaitSet.
+            /// \note       Thread-safe and re-entrant.
+            bool IsReady() {
+                return count_.load(std::memory_order_seq_cst) != 0;
+            }
+
+        private:
+
+            /// \brief      Takes count permits if they are available.
+            /// \param[out] available   The count that was last seen, to park on if the permits were not taken.
+            /// \returns    True if the permits were taken.
+            bool TryAcquire(uint32_t count, uint32_t& available) {
+                available = count_.load(std::memory_order_seq_cst);
+                while(available >= count) {
+                    if(count_.compare_exchange_weak(available, available - count, std::memory_order_seq_cst))
+                        return true;
+                }
+                return false;
+            }
+
+            bool TryAcquire(uint32_t count) {
+                uint32_t available;
+                return TryAcquire(count, available);
+            }
+
+            /// \brief      Must be called before parking, so that Notify() knows to wake this thread.
+            void AddWaiter(uint32_t count) {
+                if(count > 1)
+                    numMultiWaiters_.fetch_add(1, std::memory_order_relaxed);
+                numWaiters_.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            void RemoveWaiter(uint32_t count) {
+                numWaiters_.fetch_sub(1, std::memory_order_relaxed);
+                if(count > 1)
+                    numMultiWaiters_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            /// \brief      Spins for up to the current spin limit waiting for count permits to become available, and
+            ///             adapts the spin limit depending on whether they did.
+            /// \returns    True if the permits were taken.
+            bool Spin(uint32_t count) {
+                static const bool isMultiCore = std::thread::hardware_concurrency() > 1;
+                if(!isMultiCore)
+                    return false;
+
+                auto spinLimit = spinLimit_.load(std::memory_order_relaxed);
+                for(uint32_t i = 0; i < spinLimit; i++) {
+                    CpuRelax();
+                    if(count_.load(std::memory_order_relaxed) >= count && TryAcquire(count)) {
+                        spinLimit_.store(spinLimit * 2 < MAX_SPINS ? spinLimit * 2 : MAX_SPINS, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                spinLimit_.store(spinLimit / 2 > MIN_SPINS ? spinLimit / 2 : MIN_SPINS, std::memory_order_relaxed);
+                return false;
+            }
+
+            /// \brief      Tells the CPU we are in a spin loop, so it can save power and give the other hyper-thread
+            ///             on the core a go.
+            static void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+                __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+                asm volatile("yield");
+#endif
+            }
+
+            /// \brief      The count, which is also the futex word parked threads wait on (while it is too small).
+            std::atomic<uint32_t> count_{0};
+
+            /// \brief      The number of threads parked (or about to park) on the futex, and how many of those are
+            ///             waiting for more than one permit.
+            std::atomic<uint32_t> numWaiters_{0};
+            std::atomic<uint32_t> numMultiWaiters_{0};
+
+            std::atomic<uint32_t> spinLimit_{MIN_SPINS * 8};
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_FUTEX_SEMAPHORE_H_
@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-13
-/// \last-modified		2017-10-13
+/// \last-modified		2026-10-17
 /// \brief 				Contains the HeapTracker class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -63,6 +63,7 @@ namespace mn {
                 std::unique_lock<std::mutex> lock(mutex_);
                 HeapTracker::Instance().heapMap->insert(std::make_pair(memoryAddress, size));
                 allocatedHeapMem_B += size;
+                numAllocations_++;
             }
 
             void RemoveHeapAllocation(void *memoryAddress) {
@@ -76,10 +77,18 @@ namespace mn {
                 return allocatedHeapMem_B;
             }
 
+            /// \returns    The total number of heap allocations that have been made (freed or not). Useful for
+            ///             checking that a piece of code does not allocate.
+            std::size_t GetNumAllocations() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                return numAllocations_;
+            }
+
         private:
 
             HeapMapType *heapMap;
             std::size_t allocatedHeapMem_B = 0;
+            std::size_t numAllocations_ = 0;
             std::mutex mutex_;
 
             HeapTracker() {
@@ -0,0 +1,204 @@
+///
+/// \file 				InlineFunction.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the InlineFunction class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_INLINE_FUNCTION_H_
+#define MN_CPP_UTILS_INLINE_FUNCTION_H_
+
+// System includes
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mn {
+    namespace CppUtils {
+
+        template<typename Signature, std::size_t Capacity = 48>
+        class InlineFunction;
+
+        /// \brief      A move-only alternative to std::function which stores the callable object inside a fixed size
+        ///             buffer within the InlineFunction itself, rather than on the heap.
+        /// \details    Callables which are no bigger than Capacity bytes (e.g. lambdas which capture a few pointers or
+        ///             references) are stored inline, so creating, moving and calling the InlineFunction never
+        ///             allocates. Larger callables are still supported, but are stored on the heap.
+        ///             Constructing from an empty std::function or a null function pointer creates an empty
+        ///             InlineFunction.
+        template<typename R, typename... Args, std::size_t Capacity>
+        class InlineFunction<R(Args...), Capacity> {
+        public:
+
+            InlineFunction() {}
+
+            InlineFunction(std::nullptr_t) {}
+
+            template<typename F, typename = typename std::enable_if<
+                    !std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+            InlineFunction(F&& callable) {
+                Construct(std::forward<F>(callable));
+            }
+
+            InlineFunction(const InlineFunction&) = delete;
+            InlineFunction& operator=(const InlineFunction&) = delete;
+
+            InlineFunction(InlineFunction&& rhs) noexcept {
+                MoveFrom(rhs);
+            }
+
+            InlineFunction& operator=(InlineFunction&& rhs) noexcept {
+                if(this != &rhs) {
+                    Reset();
+                    MoveFrom(rhs);
+                }
+                return *this;
+            }
+
+            ~InlineFunction() {
+                Reset();
+            }
+
+            /// \brief      Destroys the stored callable (if any), leaving the InlineFunction empty.
+            void Reset() {
+                if(ops_) {
+                    ops_->destroy(&storage_);
+                    ops_ = nullptr;
+                }
+            }
+
+            /// \returns    True if there is a callable object stored, otherwise false.
+            explicit operator bool() const {
+                return ops_ != nullptr;
+            }
+
+            /// \brief      Calls the stored callable.
+            /// \throws     std::bad_function_call if the InlineFunction is empty.
+            R operator()(Args... args) const {
+                if(!ops_)
+                    throw std::bad_function_call();
+                return ops_->invoke(&storage_, std::forward<Args>(args)...);
+            }
+
+            /// \returns    True if a callable of type F will be stored inline (i.e. without allocating).
+            template<typename F>
+            static constexpr bool IsStoredInline() {
+                return sizeof(F) <= Capacity &&
+                       alignof(F) <= alignof(Storage) &&
+                       std::is_nothrow_move_constructible<F>::value;
+            }
+
+        private:
+
+            using Storage = typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type;
+
+            /// \brief      Type-erased operations on the stored callable. There is one static instance of this per
+            ///             stored callable type.
+            struct Ops {
+                R (*invoke)(void* storage, Args&&... args);
+                void (*move)(void* dst, void* src);
+                void (*destroy)(void* storage);
+            };
+
+            /// \brief      Ops for a callable that is stored directly in storage_.
+            template<typename F>
+            struct InlineOps {
+                static R Invoke(void* storage, Args&&... args) {
+                    return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+                }
+
+                static void Move(void* dst, void* src) {
+                    new(dst) F(std::move(*static_cast<F*>(src)));
+                    static_cast<F*>(src)->~F();
+                }
+
+                static void Destroy(void* storage) {
+                    static_cast<F*>(storage)->~F();
+                }
+
+                static const Ops* Get() {
+                    static const Ops ops = { &Invoke, &Move, &Destroy };
+                    return &ops;
+                }
+            };
+
+            /// \brief      Ops for a callable that is too big to be stored inline. storage_ holds a pointer to the
+            ///             callable on the heap instead.
+            template<typename F>
+            struct HeapOps {
+                static R Invoke(void* storage, Args&&... args) {
+                    return (**static_cast<F**>(storage))(std::forward<Args>(args)...);
+                }
+
+                static void Move(void* dst, void* src) {
+                    *static_cast<F**>(dst) = *static_cast<F**>(src);
+                }
+
+                static void Destroy(void* storage) {
+                    delete *static_cast<F**>(storage);
+                }
+
+                static const Ops* Get() {
+                    static const Ops ops = { &Invoke, &Move, &Destroy };
+                    return &ops;
+                }
+            };
+
+            template<typename T>
+            static bool IsNull(const T&) {
+                return false;
+            }
+
+            template<typename T>
+            static bool IsNull(T* pointer) {
+                return pointer == nullptr;
+            }
+
+            template<typename Signature>
+            static bool IsNull(const std::function<Signature>& function) {
+                return !function;
+            }
+
+            template<typename F>
+            void Construct(F&& callable) {
+                using Callable = typename std::decay<F>::type;
+                if(IsNull(callable))
+                    return;
+                ConstructImpl<Callable>(std::forward<F>(callable),
+                                        std::integral_constant<bool, IsStoredInline<Callable>()>());
+            }
+
+            template<typename Callable, typename F>
+            void ConstructImpl(F&& callable, std::true_type /* storedInline */) {
+                new(&storage_) Callable(std::forward<F>(callable));
+                ops_ = InlineOps<Callable>::Get();
+            }
+
+            template<typename Callable, typename F>
+            void ConstructImpl(F&& callable, std::false_type /* storedInline */) {
+                *reinterpret_cast<Callable**>(&storage_) = new Callable(std::forward<F>(callable));
+                ops_ = HeapOps<Callable>::Get();
+            }
+
+            void MoveFrom(InlineFunction& rhs) {
+                if(rhs.ops_) {
+                    rhs.ops_->move(&storage_, &rhs.storage_);
+                    ops_ = rhs.ops_;
+                    rhs.ops_ = nullptr;
+                }
+            }
+
+            mutable Storage storage_;
+            const Ops* ops_ = nullptr;
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_INLINE_FUNCTION_H_
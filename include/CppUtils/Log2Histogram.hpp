@@ -0,0 +1,187 @@
+///
+/// \file 				Log2Histogram.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the Log2Histogram class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_LOG2_HISTOGRAM_H_
+#define MN_CPP_UTILS_LOG2_HISTOGRAM_H_
+
+// System includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      A copy of the counts in a Log2Histogram, taken at one point in time.
+        class Log2HistogramSnapshot {
+        public:
+
+            static constexpr std::size_t NUM_BUCKETS = 64;
+
+            Log2HistogramSnapshot() {
+                counts_.fill(0);
+            }
+
+            /// \returns    The number of values recorded in the bucket. Bucket 0 holds values of 0, and bucket i
+            ///             holds values from 2^(i-1) up to (but not including) 2^i. The last bucket also holds
+            ///             everything larger.
+            uint64_t GetBucketCount(std::size_t bucket) const {
+                return counts_.at(bucket);
+            }
+
+            /// \returns    The largest value that can be recorded in the bucket.
+            static uint64_t GetBucketUpperBound(std::size_t bucket) {
+                if(bucket == 0)
+                    return 0;
+                if(bucket >= NUM_BUCKETS - 1)
+                    return UINT64_MAX;
+                return (uint64_t(1) << bucket) - 1;
+            }
+
+            /// \returns    The total number of values recorded.
+            uint64_t GetCount() const {
+                uint64_t count = 0;
+                for(auto bucketCount : counts_)
+                    count += bucketCount;
+                return count;
+            }
+
+            /// \returns    The sum of all values recorded.
+            uint64_t GetSum() const {
+                return sum_;
+            }
+
+            /// \returns    The largest value recorded, or 0 if no values have been recorded.
+            uint64_t GetMax() const {
+                return max_;
+            }
+
+            /// \returns    The mean of all values recorded, or 0 if no values have been recorded.
+            double GetMean() const {
+                auto count = GetCount();
+                return count == 0 ? 0.0 : static_cast<double>(sum_) / count;
+            }
+
+            /// \returns    An upper bound on the given percentile of the recorded values, i.e. the upper bound of the
+            ///             bucket the percentile falls in (but never more than GetMax()). Returns 0 if no values
+            ///             have been recorded.
+            /// \throws     std::invalid_argument if percentile is not between 0 and 100.
+            uint64_t GetPercentile(double percentile) const {
+                if(percentile < 0.0 || percentile > 100.0)
+                    throw std::invalid_argument(std::string() + "The value of percentile \"" +
+                                                std::to_string(percentile) + "\" provided to " +
+                                                __PRETTY_FUNCTION__ + " was not between 0 and 100.");
+
+                auto count = GetCount();
+                if(count == 0)
+                    return 0;
+
+                // The rank of the value we are looking for, rounded up so that the 100th percentile is the last value
+                auto rank = static_cast<uint64_t>(percentile / 100.0 * count);
+                if(rank == 0 || static_cast<double>(rank) < percentile / 100.0 * count)
+                    rank++;
+
+                uint64_t numBelow = 0;
+                for(std::size_t bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+                    numBelow += counts_[bucket];
+                    if(numBelow >= rank)
+                        return std::min(GetBucketUpperBound(bucket), max_);
+                }
+                return max_;
+            }
+
+            /// \brief      Adds the counts of another snapshot to this one, e.g. to combine histograms from several
+            ///             threads.
+            Log2HistogramSnapshot& operator+=(const Log2HistogramSnapshot& rhs) {
+                for(std::size_t bucket = 0; bucket < NUM_BUCKETS; bucket++)
+                    counts_[bucket] += rhs.counts_[bucket];
+                sum_ += rhs.sum_;
+                max_ = std::max(max_, rhs.max_);
+                return *this;
+            }
+
+        private:
+
+            friend class Log2Histogram;
+
+            std::array<uint64_t, NUM_BUCKETS> counts_;
+            uint64_t sum_ = 0;
+            uint64_t max_ = 0;
+        };
+
+        /// \brief      A histogram of unsigned integer values with power-of-two sized buckets, which can be recorded
+        ///             into from any number of threads at once without locking.
+        /// \details    Recording a value is a count-leading-zeros plus three relaxed atomic operations, so it is cheap
+        ///             enough to do on every event of a hot path. Use GetSnapshot() to read the histogram from any
+        ///             thread. The counts are read one at a time, so a snapshot taken while values are being recorded
+        ///             may be off by the values recorded during the snapshot.
+        ///             This class is neither movable nor copyable.
+        class Log2Histogram {
+        public:
+
+            static constexpr std::size_t NUM_BUCKETS = Log2HistogramSnapshot::NUM_BUCKETS;
+
+            Log2Histogram() {
+                Reset();
+            }
+
+            Log2Histogram(const Log2Histogram&) = delete;
+            Log2Histogram& operator=(const Log2Histogram&) = delete;
+
+            /// \brief      Records a value in the histogram.
+            /// \note       Thread-safe, re-entrant and lock-free.
+            void Record(uint64_t value) {
+                counts_[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+                sum_.fetch_add(value, std::memory_order_relaxed);
+                auto max = max_.load(std::memory_order_relaxed);
+                while(value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed));
+            }
+
+            /// \returns    A copy of the current counts.
+            /// \note       Thread-safe and re-entrant.
+            Log2HistogramSnapshot GetSnapshot() const {
+                Log2HistogramSnapshot snapshot;
+                for(std::size_t bucket = 0; bucket < NUM_BUCKETS; bucket++)
+                    snapshot.counts_[bucket] = counts_[bucket].load(std::memory_order_relaxed);
+                snapshot.sum_ = sum_.load(std::memory_order_relaxed);
+                snapshot.max_ = max_.load(std::memory_order_relaxed);
+                return snapshot;
+            }
+
+            /// \brief      Clears all the counts.
+            /// \note       Thread-safe and re-entrant, but values recorded during the reset may be partly lost.
+            void Reset() {
+                for(auto& count : counts_)
+                    count.store(0, std::memory_order_relaxed);
+                sum_.store(0, std::memory_order_relaxed);
+                max_.store(0, std::memory_order_relaxed);
+            }
+
+            /// \returns    The bucket that the value is recorded in.
+            static std::size_t GetBucket(uint64_t value) {
+                if(value == 0)
+                    return 0;
+                return std::min<std::size_t>(64 - __builtin_clzll(value), NUM_BUCKETS - 1);
+            }
+
+        private:
+            std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts_;
+            std::atomic<uint64_t> sum_;
+            std::atomic<uint64_t> max_;
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_LOG2_HISTOGRAM_H_
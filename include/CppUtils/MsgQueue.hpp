@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-24
-/// \last-modified		2017-10-24
+/// \last-modified		2026-10-17
 /// \brief 				Contains the MsgQueue class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -12,10 +12,26 @@
 #define MN_CPP_UTILS_MSG_QUEUE_H_
 
 // System includes
-#include <queue>
 #include <mutex>
-#include <future>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// User includes
+#include "Futex.hpp"
+#include "WaitSet.hpp"
 
 namespace mn {
     namespace CppUtils {
@@ -23,6 +39,556 @@ namespace mn {
 
             using VData = std::shared_ptr<void>;
 
+            /// \brief      Identifies the type of a message. A 32-bit integer, so copying and comparing one is cheap, and
+            ///             receivers can dispatch on it with a switch.
+            /// \details    IDs are made from names with the 32-bit FNV-1a hash. For string literals the hash is
+            ///             calculated at compile time, with the _msgId literal (e.g. "EXIT"_msgId) or a constexpr
+            ///             MsgId. IDs can also be given a value directly (e.g. from an enum).
+            ///             The names are not stored. To get a name back for debugging, register it with Register(),
+            ///             which also checks that no two registered names hash to the same ID.
+            class MsgId {
+            public:
+
+                constexpr MsgId() : value_(0) {}
+
+                constexpr explicit MsgId(uint32_t value) : value_(value) {}
+
+                /// \brief      Creates the ID for the given name. Implicit, so string literals can be given wherever a
+                ///             MsgId is expected.
+                constexpr MsgId(const char* name) : value_(Hash(name)) {}
+
+                /// \brief      Creates the ID for the given name. The hash is calculated at run time.
+                MsgId(const std::string& name) : value_(Hash(name.data(), name.size())) {}
+
+                /// \returns    The integer value, so MsgIds can be used in a switch statement and as case labels.
+                constexpr operator uint32_t() const {
+                    return value_;
+                }
+
+                constexpr uint32_t GetValue() const {
+                    return value_;
+                }
+
+                friend constexpr bool operator==(MsgId lhs, MsgId rhs) {
+                    return lhs.value_ == rhs.value_;
+                }
+
+                friend constexpr bool operator!=(MsgId lhs, MsgId rhs) {
+                    return lhs.value_ != rhs.value_;
+                }
+
+                /// \brief      Records the name of an ID, so it can be returned by GetName().
+                /// \returns    The ID for the name.
+                /// \throws     std::invalid_argument if a different name with the same ID has already been registered.
+                /// \note       Thread-safe and re-entrant.
+                static MsgId Register(const std::string& name) {
+                    MsgId id(name);
+                    auto& registry = GetRegistry();
+                    std::lock_guard<std::mutex> lock(registry.mutex_);
+                    auto it = registry.names_.find(id.value_);
+                    if(it != registry.names_.end() && it->second != name)
+                        throw std::invalid_argument(std::string() + "name \"" + name + "\" provided to " +
+                                                    __PRETTY_FUNCTION__ + " has the same ID as the registered name \"" +
+                                                    it->second + "\".");
+                    registry.names_[id.value_] = name;
+                    return id;
+                }
+
+                /// \returns    The name registered with Register() for this ID, or the ID in hex (e.g. "0x1A2B3C4D")
+                ///             if none was.
+                /// \note       Thread-safe and re-entrant.
+                std::string GetName() const {
+                    auto& registry = GetRegistry();
+                    {
+                        std::lock_guard<std::mutex> lock(registry.mutex_);
+                        auto it = registry.names_.find(value_);
+                        if(it != registry.names_.end())
+                            return it->second;
+                    }
+                    std::ostringstream name;
+                    name << "0x" << std::hex << std::uppercase << std::setw(8) << std::setfill('0') << value_;
+                    return name.str();
+                }
+
+                /// \brief      The 32-bit FNV-1a hash of a null-terminated string.
+                static constexpr uint32_t Hash(const char* name) {
+                    uint32_t hash = FNV_OFFSET_BASIS;
+                    while(*name != '\0') {
+                        hash ^= static_cast<uint8_t>(*name++);
+                        hash *= FNV_PRIME;
+                    }
+                    return hash;
+                }
+
+                /// \brief      The 32-bit FNV-1a hash of a string of the given length.
+                static constexpr uint32_t Hash(const char* name, std::size_t length) {
+                    uint32_t hash = FNV_OFFSET_BASIS;
+                    for(std::size_t i = 0; i < length; i++) {
+                        hash ^= static_cast<uint8_t>(name[i]);
+                        hash *= FNV_PRIME;
+                    }
+                    return hash;
+                }
+
+            private:
+
+                static constexpr uint32_t FNV_OFFSET_BASIS = 2166136261u;
+                static constexpr uint32_t FNV_PRIME = 16777619u;
+
+                struct Registry {
+                    std::mutex mutex_;
+                    std::unordered_map<uint32_t, std::string> names_;
+                };
+
+                static Registry& GetRegistry() {
+                    static Registry registry;
+                    return registry;
+                }
+
+                uint32_t value_;
+            };
+
+            /// \brief      Creates a MsgId from a string literal at compile time, e.g. "EXIT"_msgId.
+            constexpr MsgId operator""_msgId(const char* name, std::size_t length) {
+                return MsgId(MsgId::Hash(name, length));
+            }
+
+            /// \brief      A type-checked value carried by a message, stored inside the Payload itself (without
+            ///             allocating) if it is no bigger than CAPACITY bytes, otherwise on the heap.
+            /// \details    Get<T>() checks that the payload holds a T, so a receiver cannot cast it to the wrong type.
+            ///             Moving a Payload moves the value (or, for values on the heap, the pointer to it), and never
+            ///             allocates for values stored inline. Copying a Payload copies the value, and throws
+            ///             std::runtime_error if the value is not copyable.
+            class Payload {
+            public:
+
+                static constexpr std::size_t CAPACITY = 64;
+
+                Payload() {}
+
+                template<typename T, typename = typename std::enable_if<
+                        !std::is_same<typename std::decay<T>::type, Payload>::value>::type>
+                Payload(T&& value) {
+                    Emplace<typename std::decay<T>::type>(std::forward<T>(value));
+                }
+
+                Payload(const Payload& rhs) {
+                    CopyFrom(rhs);
+                }
+
+                Payload(Payload&& rhs) noexcept {
+                    MoveFrom(rhs);
+                }
+
+                Payload& operator=(const Payload& rhs) {
+                    if(this != &rhs) {
+                        Reset();
+                        CopyFrom(rhs);
+                    }
+                    return *this;
+                }
+
+                Payload& operator=(Payload&& rhs) noexcept {
+                    if(this != &rhs) {
+                        Reset();
+                        MoveFrom(rhs);
+                    }
+                    return *this;
+                }
+
+                ~Payload() {
+                    Reset();
+                }
+
+                /// \brief      Replaces the value with a T constructed from the given arguments.
+                /// \returns    The new value.
+                template<typename T, typename ...Arg>
+                T& Emplace(Arg&&... args) {
+                    Reset();
+                    return EmplaceImpl<T>(std::integral_constant<bool, IsStoredInline<T>()>(), std::forward<Arg>(args)...);
+                }
+
+                /// \returns    True if the payload holds a value of type T.
+                template<typename T>
+                bool Holds() const {
+                    return ops_ != nullptr && ops_ == GetOps<T>();
+                }
+
+                /// \returns    The value.
+                /// \throws     std::runtime_error if the payload does not hold a value of type T.
+                template<typename T>
+                T& Get() {
+                    if(!Holds<T>())
+                        throw std::runtime_error(std::string() + __PRETTY_FUNCTION__ +
+                                                 " called but the payload does not hold a value of this type.");
+                    return *static_cast<T*>(ops_->get(&storage_));
+                }
+
+                /// \returns    A pointer to the value, or nullptr if the payload does not hold a value of type T.
+                template<typename T>
+                T* GetIf() {
+                    return Holds<T>() ? static_cast<T*>(ops_->get(&storage_)) : nullptr;
+                }
+
+                /// \returns    True if the payload holds a value.
+                bool HasValue() const {
+                    return ops_ != nullptr;
+                }
+
+                /// \returns    True if the payload holds a value which is stored inline.
+                bool IsInline() const {
+                    return ops_ != nullptr && ops_->isInline_;
+                }
+
+                /// \brief      Destroys the value (if any), leaving the payload empty.
+                void Reset() {
+                    if(ops_) {
+                        ops_->destroy(&storage_);
+                        ops_ = nullptr;
+                    }
+                }
+
+                /// \returns    True if a value of type T will be stored inline (i.e. without allocating).
+                template<typename T>
+                static constexpr bool IsStoredInline() {
+                    return sizeof(T) <= CAPACITY &&
+                           alignof(T) <= alignof(Storage) &&
+                           std::is_nothrow_move_constructible<T>::value;
+                }
+
+            private:
+
+                using Storage = typename std::aligned_storage<CAPACITY, alignof(std::max_align_t)>::type;
+
+                /// \brief      Type-erased operations on the stored value. There is one static instance of this per
+                ///             stored type, so the address of it also identifies the type.
+                struct Ops {
+                    void* (*get)(void* storage);
+                    void (*copy)(void* dst, const void* src);
+                    void (*move)(void* dst, void* src);
+                    void (*destroy)(void* storage);
+                    bool isInline_;
+                };
+
+                template<typename T>
+                static void Copy(void* dst, const T& src, std::true_type /* isCopyable */) {
+                    new(dst) T(src);
+                }
+
+                template<typename T>
+                static void Copy(void*, const T&, std::false_type /* isCopyable */) {
+                    throw std::runtime_error(std::string() + __PRETTY_FUNCTION__ +
+                                             " called but the payload type is not copyable.");
+                }
+
+                /// \brief      Ops for a value that is stored directly in storage_.
+                template<typename T>
+                struct InlineOps {
+                    static void* Get(void* storage) {
+                        return storage;
+                    }
+
+                    static void CopyValue(void* dst, const void* src) {
+                        Copy<T>(dst, *static_cast<const T*>(src), std::is_copy_constructible<T>());
+                    }
+
+                    static void Move(void* dst, void* src) {
+                        new(dst) T(std::move(*static_cast<T*>(src)));
+                        static_cast<T*>(src)->~T();
+                    }
+
+                    static void Destroy(void* storage) {
+                        static_cast<T*>(storage)->~T();
+                    }
+
+                    static const Ops* GetOps() {
+                        static const Ops ops = { &Get, &CopyValue, &Move, &Destroy, true };
+                        return &ops;
+                    }
+                };
+
+                /// \brief      Ops for a value that is too big to be stored inline. storage_ holds a pointer to the
+                ///             value on the heap instead.
+                template<typename T>
+                struct HeapOps {
+                    static void* Get(void* storage) {
+                        return *static_cast<T**>(storage);
+                    }
+
+                    static void CopyValue(void* dst, const void* src) {
+                        auto value = static_cast<T*>(::operator new(sizeof(T)));
+                        try {
+                            Copy<T>(value, **static_cast<T* const*>(src), std::is_copy_constructible<T>());
+                        } catch(...) {
+                            ::operator delete(value);
+                            throw;
+                        }
+                        *static_cast<T**>(dst) = value;
+                    }
+
+                    static void Move(void* dst, void* src) {
+                        *static_cast<T**>(dst) = *static_cast<T**>(src);
+                    }
+
+                    static void Destroy(void* storage) {
+                        delete *static_cast<T**>(storage);
+                    }
+
+                    static const Ops* GetOps() {
+                        static const Ops ops = { &Get, &CopyValue, &Move, &Destroy, false };
+                        return &ops;
+                    }
+                };
+
+                template<typename T>
+                static const Ops* GetOps() {
+                    return std::conditional<IsStoredInline<T>(), InlineOps<T>, HeapOps<T>>::type::GetOps();
+                }
+
+                template<typename T, typename ...Arg>
+                T& EmplaceImpl(std::true_type /* storedInline */, Arg&&... args) {
+                    auto value = new(&storage_) T(std::forward<Arg>(args)...);
+                    ops_ = GetOps<T>();
+                    return *value;
+                }
+
+                template<typename T, typename ...Arg>
+                T& EmplaceImpl(std::false_type /* storedInline */, Arg&&... args) {
+                    auto value = new T(std::forward<Arg>(args)...);
+                    *reinterpret_cast<T**>(&storage_) = value;
+                    ops_ = GetOps<T>();
+                    return *value;
+                }
+
+                void CopyFrom(const Payload& rhs) {
+                    if(rhs.ops_) {
+                        rhs.ops_->copy(&storage_, &rhs.storage_);
+                        ops_ = rhs.ops_;
+                    }
+                }
+
+                void MoveFrom(Payload& rhs) {
+                    if(rhs.ops_) {
+                        rhs.ops_->move(&storage_, &rhs.storage_);
+                        ops_ = rhs.ops_;
+                        rhs.ops_ = nullptr;
+                    }
+                }
+
+                Storage storage_;
+                const Ops* ops_ = nullptr;
+            };
+
+            /// \brief      A one-shot channel for the reply to a message, used by messages with
+            ///             ReturnType::RETURN_DATA in place of a std::promise/std::future pair.
+            /// \details    ReplyChannel is a reference counted handle to a slot taken from a global pool, and the slot
+            ///             goes back to the pool when the last handle is destroyed, so once the pool has grown to the
+            ///             peak number of outstanding requests, creating a channel does not allocate. Each slot has a
+            ///             single atomic state word. Waiting for the reply parks on it with a futex, and giving the
+            ///             reply only makes a system call if a thread is parked.
+            ///             Copying a ReplyChannel gives another handle to the same slot.
+            class ReplyChannel {
+            public:
+
+                /// \brief      Creates a handle which is not attached to a slot.
+                ReplyChannel() {}
+
+                ReplyChannel(const ReplyChannel& rhs) : slot_(rhs.slot_) {
+                    if(slot_)
+                        slot_->numRefs_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                ReplyChannel(ReplyChannel&& rhs) noexcept : slot_(rhs.slot_) {
+                    rhs.slot_ = nullptr;
+                }
+
+                ReplyChannel& operator=(const ReplyChannel& rhs) {
+                    if(this != &rhs) {
+                        if(rhs.slot_)
+                            rhs.slot_->numRefs_.fetch_add(1, std::memory_order_relaxed);
+                        Reset();
+                        slot_ = rhs.slot_;
+                    }
+                    return *this;
+                }
+
+                ReplyChannel& operator=(ReplyChannel&& rhs) noexcept {
+                    if(this != &rhs) {
+                        Reset();
+                        slot_ = rhs.slot_;
+                        rhs.slot_ = nullptr;
+                    }
+                    return *this;
+                }
+
+                ~ReplyChannel() {
+                    Reset();
+                }
+
+                /// \brief      Creates a channel with a slot from the pool.
+                /// \note       Thread-safe and re-entrant.
+                static ReplyChannel Create() {
+                    ReplyChannel channel;
+                    channel.slot_ = GetPool().Acquire();
+                    return channel;
+                }
+
+                /// \returns    True if this handle is attached to a slot.
+                bool IsValid() const {
+                    return slot_ != nullptr;
+                }
+
+                /// \brief      Gives the reply, and wakes up any thread waiting for it.
+                /// \throws     std::runtime_error if the handle is not attached to a slot, or a reply has already been
+                ///             given.
+                /// \note       Thread-safe and re-entrant.
+                void SetReply(Payload reply) {
+                    CheckValid(__PRETTY_FUNCTION__);
+                    if(slot_->state_.fetch_or(CLAIMED, std::memory_order_acquire) & CLAIMED)
+                        throw std::runtime_error(std::string() + __PRETTY_FUNCTION__ +
+                                                 " called but a reply has already been given.");
+                    slot_->reply_ = std::move(reply);
+                    if(slot_->state_.fetch_or(READY, std::memory_order_release) & WAITER)
+                        Futex::WakeAll(slot_->state_);
+                }
+
+                /// \returns    True if the reply has been given (i.e. GetReply() can be called without waiting).
+                /// \note       Thread-safe and re-entrant. Never blocks.
+                bool IsReady() const {
+                    return slot_ != nullptr && (slot_->state_.load(std::memory_order_acquire) & READY);
+                }
+
+                /// \brief      Blocks indefinitely until the reply has been given.
+                /// \throws     std::runtime_error if the handle is not attached to a slot.
+                /// \note       Thread-safe and re-entrant.
+                void Wait() {
+                    CheckValid(__PRETTY_FUNCTION__);
+                    uint32_t state;
+                    while(!PrepareToPark(state))
+                        Futex::Wait(slot_->state_, state);
+                }
+
+                /// \brief      Blocks until either the reply has been given, or a timeout occurs. A timeout of 0 polls
+                ///             without blocking.
+                /// \returns    True if the reply has been given, otherwise false.
+                /// \throws     std::runtime_error if the handle is not attached to a slot.
+                /// \note       Thread-safe and re-entrant.
+                bool WaitFor(std::chrono::milliseconds timeout) {
+                    CheckValid(__PRETTY_FUNCTION__);
+                    auto deadline = std::chrono::steady_clock::now() + timeout;
+                    uint32_t state;
+                    while(!PrepareToPark(state)) {
+                        if(!Futex::WaitFor(slot_->state_, state, deadline - std::chrono::steady_clock::now()))
+                            return IsReady();
+                    }
+                    return true;
+                }
+
+                /// \returns    The reply. Only call once IsReady() is true (or Wait() has returned).
+                Payload& GetReply() {
+                    CheckValid(__PRETTY_FUNCTION__);
+                    return slot_->reply_;
+                }
+
+                /// \brief      Detaches this handle from it's slot, returning the slot to the pool if this was the last
+                ///             handle.
+                void Reset() {
+                    if(slot_ && slot_->numRefs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        GetPool().Release(slot_);
+                    slot_ = nullptr;
+                }
+
+                /// \returns    The number of slots the pool has allocated, whether in use or not.
+                /// \note       Thread-safe and re-entrant.
+                static std::size_t GetPoolSize() {
+                    return GetPool().GetSize();
+                }
+
+            private:
+
+                /// \brief      Bits of Slot::state_.
+                static constexpr uint32_t READY = 1;    ///< The reply has been written.
+                static constexpr uint32_t CLAIMED = 2;  ///< A reply is being (or has been) written.
+                static constexpr uint32_t WAITER = 4;   ///< A thread is parked (or about to park) on the futex.
+
+                struct Slot {
+                    std::atomic<uint32_t> state_{0};
+                    std::atomic<uint32_t> numRefs_{0};
+                    Payload reply_;
+                };
+
+                /// \brief      The free list of slots. Slots are allocated in chunks which are only freed when the pool
+                ///             is destroyed.
+                class Pool {
+                public:
+
+                    static constexpr std::size_t CHUNK_SIZE = 64;
+
+                    Slot* Acquire() {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if(free_.empty())
+                            Grow();
+                        auto slot = free_.back();
+                        free_.pop_back();
+                        slot->numRefs_.store(1, std::memory_order_relaxed);
+                        return slot;
+                    }
+
+                    void Release(Slot* slot) {
+                        slot->reply_.Reset();
+                        slot->state_.store(0, std::memory_order_relaxed);
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        free_.push_back(slot);
+                    }
+
+                    std::size_t GetSize() {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        return chunks_.size() * CHUNK_SIZE;
+                    }
+
+                private:
+
+                    void Grow() {
+                        chunks_.push_back(std::unique_ptr<Slot[]>(new Slot[CHUNK_SIZE]));
+                        free_.reserve(chunks_.size() * CHUNK_SIZE);
+                        for(std::size_t i = 0; i < CHUNK_SIZE; i++)
+                            free_.push_back(&chunks_.back()[i]);
+                    }
+
+                    std::mutex mutex_;
+                    std::vector<std::unique_ptr<Slot[]>> chunks_;
+                    std::vector<Slot*> free_;
+                };
+
+                static Pool& GetPool() {
+                    static Pool pool;
+                    return pool;
+                }
+
+                /// \brief      Checks whether the reply is ready, and if not, marks the slot as having a waiter.
+                /// \param[out] state   The state to park on if the reply is not ready.
+                /// \returns    True if the reply is ready.
+                bool PrepareToPark(uint32_t& state) {
+                    state = slot_->state_.load(std::memory_order_acquire);
+                    while(!(state & READY)) {
+                        if(state & WAITER)
+                            return false;
+                        if(slot_->state_.compare_exchange_weak(state, state | WAITER, std::memory_order_acquire)) {
+                            state |= WAITER;
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                void CheckValid(const char* function) const {
+                    if(!slot_)
+                        throw std::runtime_error(std::string() + function + " called but the channel has no slot.");
+                }
+
+                Slot* slot_ = nullptr;
+            };
+
             enum class ReturnType {
                 NO_RETURN_DATA,
                 RETURN_DATA
@@ -33,39 +599,88 @@ namespace mn {
 
                 friend class RxMsg;
 
-                TxMsg(std::string id, ReturnType returnType = ReturnType::NO_RETURN_DATA) {
+                /// \brief      Creates a message with a 0 ID and no data.
+                TxMsg() {}
+
+                TxMsg(MsgId id, ReturnType returnType = ReturnType::NO_RETURN_DATA) {
                     id_ = id;
                     returnType_ = returnType;
 
-                    if(returnType == ReturnType::RETURN_DATA) {
-                        promise_ = std::make_shared<std::promise<VData>>();
-                        future_ = std::make_shared<std::future<VData>>(promise_->get_future());
-                    }
+                    if(returnType == ReturnType::RETURN_DATA)
+                        reply_ = ReplyChannel::Create();
 
                 }
 
                 template<typename T>
-                TxMsg(std::string id, T data, ReturnType returnType = ReturnType::NO_RETURN_DATA) {
-                    id_ = id;
+                TxMsg(MsgId id, std::shared_ptr<T> data, ReturnType returnType = ReturnType::NO_RETURN_DATA) :
+                        TxMsg(id, returnType) {
                     data_ = std::static_pointer_cast<void>(data);
                 }
 
+                /// \brief      Creates a message carrying a typed payload, e.g. TxMsg("POSITION"_msgId, Position{ x, y }).
+                ///             Payloads of up to Payload::CAPACITY bytes are stored inside the message, so pushing and
+                ///             popping the message does not allocate.
+                TxMsg(MsgId id, Payload payload, ReturnType returnType = ReturnType::NO_RETURN_DATA) :
+                        TxMsg(id, returnType) {
+                    payload_ = std::move(payload);
+                }
+
 
+                /// \brief      Blocks indefinitely until the receiver calls RxMsg::ReturnData().
+                /// \returns    The data returned by the receiver.
+                /// \throws     std::runtime_error if returnType was not set to RETURN_DATA, or the receiver returned a
+                ///             payload which is not VData (see RxMsg::ReturnPayload()).
                 VData WaitForData() {
-                    if(returnType_ != ReturnType::RETURN_DATA)
-                        throw std::runtime_error(std::string() + __PRETTY_FUNCTION__ + " called but returnType not set to RETURN_DATA.");
+                    return WaitForReply().Get<VData>();
+                }
+
+                /// \brief      Blocks until either the receiver calls RxMsg::ReturnData(), or a timeout occurs. A
+                ///             timeout of 0 polls without blocking.
+                /// \param[out] data    Set to the data returned by the receiver.
+                /// \returns    True if data was returned before the timeout occurred, otherwise false.
+                /// \throws     std::runtime_error, see WaitForData().
+                bool TryWaitForData(VData& data, std::chrono::milliseconds timeout) {
+                    auto reply = TryWaitForReply(timeout);
+                    if(!reply)
+                        return false;
+                    data = reply->Get<VData>();
+                    return true;
+                }
 
-                    future_->wait();
-                    return future_->get();
+                /// \brief      Blocks indefinitely until the receiver calls RxMsg::ReturnPayload() (or ReturnData()).
+                /// \returns    The payload returned by the receiver.
+                /// \throws     std::runtime_error if returnType was not set to RETURN_DATA.
+                Payload& WaitForReply() {
+                    CheckReturnType(__PRETTY_FUNCTION__);
+                    reply_.Wait();
+                    return reply_.GetReply();
+                }
+
+                /// \brief      Blocks until either the receiver calls RxMsg::ReturnPayload() (or ReturnData()), or a
+                ///             timeout occurs. A timeout of 0 polls without blocking.
+                /// \returns    The payload returned by the receiver, or nullptr if the timeout occurred.
+                /// \throws     std::runtime_error if returnType was not set to RETURN_DATA.
+                Payload* TryWaitForReply(std::chrono::milliseconds timeout) {
+                    CheckReturnType(__PRETTY_FUNCTION__);
+                    if(!reply_.WaitFor(timeout))
+                        return nullptr;
+                    return &reply_.GetReply();
                 }
 
             protected:
 
-                std::string id_;
+                MsgId id_;
                 VData data_;
-                std::shared_ptr<std::promise<VData>> promise_;
-                std::shared_ptr<std::future<VData>> future_;
-                ReturnType returnType_;
+                Payload payload_;
+                ReplyChannel reply_;
+                ReturnType returnType_ = ReturnType::NO_RETURN_DATA;
+
+            private:
+
+                void CheckReturnType(const char* function) {
+                    if(returnType_ != ReturnType::RETURN_DATA)
+                        throw std::runtime_error(std::string() + function + " called but returnType not set to RETURN_DATA.");
+                }
             };
 
             class RxMsg {
@@ -82,42 +697,79 @@ namespace mn {
                     return data_;
                 }
 
+                /// \returns    The typed payload of the message, see Payload::Get().
+                Payload& GetPayload() {
+                    return payload_;
+                }
+
                 void ReturnData(VData data) {
+                    ReturnPayload(Payload(std::move(data)));
+                }
+
+                /// \brief      Returns a typed payload to the sender, which gets it from TxMsg::WaitForReply(). Small
+                ///             payloads are returned without allocating.
+                /// \throws     std::runtime_error if returnType_ != RETURN_DATA, or a reply has already been returned.
+                void ReturnPayload(Payload payload) {
                     if(returnType_ != ReturnType::RETURN_DATA)
                         throw std::runtime_error(std::string() + __PRETTY_FUNCTION__ + " called but returnType_ != RETURN_DATA.");
 
-                    promise_->set_value(data);
+                    reply_.SetReply(std::move(payload));
                 }
 
-                RxMsg& operator=(TxMsg rhs) {
+                RxMsg& operator=(const TxMsg& rhs) {
                     id_ = rhs.id_;
                     data_ = rhs.data_;
-                    promise_ = rhs.promise_;
+                    payload_ = rhs.payload_;
+                    reply_ = rhs.reply_;
                     returnType_ = rhs.returnType_;
                     return *this;
                 }
 
-                std::string GetId() {
+                RxMsg& operator=(TxMsg&& rhs) {
+                    id_ = rhs.id_;
+                    data_ = std::move(rhs.data_);
+                    payload_ = std::move(rhs.payload_);
+                    reply_ = std::move(rhs.reply_);
+                    returnType_ = rhs.returnType_;
+                    return *this;
+                }
+
+                MsgId GetId() const {
                     return id_;
                 }
 
             protected:
-                std::string id_;
+                MsgId id_;
                 VData data_;
-                std::shared_ptr<std::promise<VData>> promise_;
-                ReturnType returnType_;
+                Payload payload_;
+                ReplyChannel reply_;
+                ReturnType returnType_ = ReturnType::NO_RETURN_DATA;
             };
 
             /// \brief       A thread-safe queue designed for inter-thread communication.
-            class MsgQueue {
+            /// \details     Messages are kept in a ring buffer which doubles in size when full, so once it has grown
+            ///              to the peak number of queued messages, Push() and Pop() do not allocate (as long as the
+            ///              messages carry no data other than a small Payload).
+            class MsgQueue : public Waitable {
             public:
 
+                static constexpr std::size_t MIN_CAPACITY = 16;
+
                 /// \brief      Adds something to the back of the thread-safe queue.
                 /// \details    This may be called from multiple threads at the "same time". Method
                 ///             will block until item can be placed onto queue.
                 void Push(const TxMsg& item) {
+                    Push(TxMsg(item));
+                }
+
+                /// \brief      Moves something onto the back of the thread-safe queue. See Push(const TxMsg&).
+                void Push(TxMsg&& item) {
                     std::unique_lock<std::mutex> uniqueLock(mutex_);
-                    queue_.push(std::move(item));
+                    if(size_ == buffer_.size())
+                        Grow();
+                    buffer_[(head_ + size_) % buffer_.size()] = std::move(item);
+                    size_++;
+                    NotifyWaitSets();
                     uniqueLock.unlock();
                     conditionVariable_.notify_one();
                 }
@@ -131,15 +783,12 @@ namespace mn {
                     std::unique_lock<std::mutex> uniqueLock(mutex_);
 
                     conditionVariable_.wait(uniqueLock, [&] {
-                        return !queue_.empty();
+                        return size_ != 0;
                     });
 
-                    // If we get here, there is an item on the queue for us, and the lock has been taken out
-                    auto txMsg = std::move(queue_.front());
-
-                    // Copy (convert) TX msg to RX msg
-                    item = std::move(txMsg);
-                    queue_.pop();
+                    // If we get here, there is an item on the queue for us, and the lock has been taken out.
+                    // Move (convert) TX msg to RX msg
+                    PopFront(item);
 
                     // Mutex will automatically be unlocked here
                     // (as it is a unique_lock)
@@ -155,14 +804,13 @@ namespace mn {
                     std::unique_lock<std::mutex> uniqueLock(mutex_);
 
                     if (!conditionVariable_.wait_for(uniqueLock, timeout, [&] {
-                        return !queue_.empty();
+                        return size_ != 0;
                     })) {
                         return false;
                     }
 
                     // If we get here, there is an item on the queue for us, and the lock has been taken out
-                    item = std::move(queue_.front());
-                    queue_.pop();
+                    PopFront(item);
 
                     // Mutex will automatically be unlocked here
                     // (as it is a unique_lock)
@@ -170,12 +818,43 @@ namespace mn {
                 }
 
                 size_t Size() {
-                    return queue_.size();
+                    std::unique_lock<std::mutex> uniqueLock(mutex_);
+                    return size_;
+                }
+
+                /// \returns    True if Pop() would not block right now (i.e. the queue is not empty). Used by WaitSet.
+                bool IsReady() {
+                    std::unique_lock<std::mutex> uniqueLock(mutex_);
+                    return size_ != 0;
                 }
 
             private:
 
-                std::queue<TxMsg> queue_;
+                /// \warning    mutex_ must be held, and the queue must not be empty.
+                void PopFront(RxMsg& item) {
+                    item = std::move(buffer_[head_]);
+                    // Release anything left in the slot (e.g. the reply channel of a message returning data)
+                    buffer_[head_] = TxMsg();
+                    head_ = (head_ + 1) % buffer_.size();
+                    size_--;
+                }
+
+                /// \brief      Doubles the capacity of the ring buffer, moving the queued messages to the start of it.
+                /// \warning    mutex_ must be held.
+                void Grow() {
+                    std::vector<TxMsg> buffer(buffer_.empty() ? MIN_CAPACITY : buffer_.size() * 2);
+                    for(std::size_t i = 0; i < size_; i++)
+                        buffer[i] = std::move(buffer_[(head_ + i) % buffer_.size()]);
+                    buffer_.swap(buffer);
+                    head_ = 0;
+                }
+
+                std::vector<TxMsg> buffer_;
+
+                /// \brief      The index of the front of the queue in buffer_.
+                std::size_t head_ = 0;
+                std::size_t size_ = 0;
+
                 std::mutex mutex_;
                 std::condition_variable conditionVariable_;
 
@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-09-22
-/// \last-modified		2017-09-22
+/// \last-modified		2026-10-17
 /// \brief 				Contains the Semaphore class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -12,51 +12,120 @@
 #define MN_CPP_UTILS_SEMAPHORE_H_
 
 // System includes
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <condition_variable>
 
+// User includes
+#include "WaitSet.hpp"
+
 namespace mn {
     namespace CppUtils {
 
         /// \details    This class is neither movable nor copyable. Use a smart pointer if you need copy/move like
         ///             capabilities.
-        class Semaphore {
+        class Semaphore : public Waitable {
         public:
 
             Semaphore() : count_(0) {
 
             }
 
-            void Notify() {
+            /// \brief      Increments the count by count (one lock, rather than count calls to Notify()), and wakes
+            ///             up as many waiting threads as the new permits can satisfy.
+            void Notify(uint32_t count = 1) {
+                if(count == 0)
+                    return;
                 std::unique_lock<std::mutex> lock(mutex_);
-                count_++;
-                cv_.notify_one();
+                count_ += count;
+
+                // Done while still holding the lock, as a woken thread may destroy the semaphore as soon as the lock
+                // is released
+                NotifyWaitSets();
+
+                // A thread waiting for several permits may not be satisfied by the ones given to it, and would then
+                // go back to sleep while another waiting thread could have been, so in that case wake them all
+                if(numMultiWaiters_ != 0 || count >= numWaiters_) {
+                    cv_.notify_all();
+                } else {
+                    for(uint32_t i = 0; i < count; i++)
+                        cv_.notify_one();
+                }
             }
 
             /// \brief      Blocks indefinitely until Notify() is called.
             void Wait() {
+                Wait(1);
+            }
+
+            /// \brief      Blocks indefinitely until count permits are available, and takes them all at once.
+            /// \details    Permits are never handed out piecemeal, so a thread waiting for several permits only
+            ///             takes them once they are all available at the same time.
+            void Wait(uint32_t count) {
                 std::unique_lock<std::mutex> lock(mutex_);
-                while(count_ == 0) {
-                    cv_.wait(lock);
+                if(count_ < count) {
+                    AddWaiter(count);
+                    while(count_ < count) {
+                        cv_.wait(lock);
+                    }
+                    RemoveWaiter(count);
                 }
-                count_--;
+                count_ -= count;
             }
 
             /// \brief      Blocks until either Notify() is called, or a timeout occurs.
             /// \returns    Returns true if Notify() was called before timeout occurred, otherwise false.
             bool TryWait(std::chrono::milliseconds timeout) {
+                return TryWait(1, timeout);
+            }
+
+            /// \brief      Blocks until either count permits are available (and takes them all at once), or a timeout
+            ///             occurs.
+            /// \returns    Returns true if the permits were taken before timeout occurred, otherwise false (in which
+            ///             case none are taken).
+            bool TryWait(uint32_t count, std::chrono::milliseconds timeout) {
                 std::unique_lock<std::mutex> lock(mutex_);
-                if(!cv_.wait_for(lock, timeout, [&] {
-                    return count_ != 0;
-                })) {
-                    return false;
+                if(count_ < count) {
+                    AddWaiter(count);
+                    bool acquired = cv_.wait_for(lock, timeout, [&] {
+                        return count_ >= count;
+                    });
+                    RemoveWaiter(count);
+                    if(!acquired)
+                        return false;
                 }
-                count_--;
+                count_ -= count;
                 return true;
             }
 
+            /// \returns    True if Wait() would not block right now (i.e. the count is positive). Used by WaitSet.
+            bool IsReady() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return count_ != 0;
+            }
+
         private:
+
+            void AddWaiter(uint32_t count) {
+                numWaiters_++;
+                if(count > 1)
+                    numMultiWaiters_++;
+            }
+
+            void RemoveWaiter(uint32_t count) {
+                numWaiters_--;
+                if(count > 1)
+                    numMultiWaiters_--;
+            }
+
             uint32_t count_;
+
+            /// \brief      The number of threads blocked in Wait() or TryWait(), and how many of those are waiting
+            ///             for more than one permit. Used by Notify() to wake only as many threads as needed.
+            uint32_t numWaiters_ = 0;
+            uint32_t numMultiWaiters_ = 0;
+
             std::mutex mutex_;
             std::condition_variable cv_;
 
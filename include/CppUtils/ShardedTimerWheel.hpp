@@ -0,0 +1,264 @@
+///
+/// \file 				ShardedTimerWheel.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the ShardedTimerWheel class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_SHARDED_TIMER_WHEEL_H_
+#define MN_CPP_UTILS_SHARDED_TIMER_WHEEL_H_
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// User includes
+#include "TimerWheel.hpp"
+
+namespace mn {
+    namespace CppUtils {
+        namespace TimerWheel {
+
+            // Forward declarations
+            class ShardedTimerWheel;
+
+            /// \brief      A handle to a timer that has been added to a ShardedTimerWheel. Remembers which shard owns
+            ///             the timer, as well as the handle to the timer within that shard.
+            class ShardedTimerHandle {
+            public:
+
+                friend ShardedTimerWheel;
+
+                ShardedTimerHandle() {}
+
+                /// \returns    The index of the shard that owns the timer.
+                uint32_t GetShard() const {
+                    return shard_;
+                }
+
+                bool operator==(const ShardedTimerHandle& rhs) const {
+                    return shard_ == rhs.shard_ && timerHandle_ == rhs.timerHandle_;
+                }
+
+                bool operator!=(const ShardedTimerHandle& rhs) const {
+                    return !(*this == rhs);
+                }
+
+            private:
+
+                ShardedTimerHandle(uint32_t shard, TimerHandle timerHandle) :
+                        shard_(shard),
+                        timerHandle_(timerHandle) {}
+
+                uint32_t shard_ = 0;
+                TimerHandle timerHandle_;
+            };
+
+            /// \brief      A front-end to a number of independent TimerWheels (shards), each with their own thread and
+            ///             inboxes.
+            /// \details    Each thread that adds timers is assigned to one shard (threads are spread across the shards
+            ///             in round-robin order the first time they add a timer to this ShardedTimerWheel, separately
+            ///             for each instance), and all timers a thread adds go to that shard. The returned handle
+            ///             remembers the owning shard, so removing a timer (from any thread) only touches that one
+            ///             shard. The only state shared between threads is the counter that hands out shards, which
+            ///             each thread touches once, so as long as there are at least as many shards as threads adding
+            ///             timers, producers never contend on the same cache lines, and each shard's timer wheel
+            ///             thread only has to keep up with it's own timers.
+            ///
+            ///             All shards are stopped and their threads joined on destruction.
+            class ShardedTimerWheel {
+            public:
+
+                /// \brief      Creates the shards and starts their threads.
+                /// \param[in]  numShards       The number of TimerWheels to create. Defaults to the number of hardware
+                ///                 threads.
+                /// \param[in]  tickDuration    Passed to each TimerWheel, see TimerWheel::TimerWheel().
+                /// \param[in]  numLevels       Passed to each TimerWheel, see TimerWheel::TimerWheel().
+                /// \param[in]  executor        Passed to each TimerWheel (so all shards share the same executor), see
+                ///                 TimerWheel::TimerWheel().
+                /// \throws     std::invalid_argument if numShards is 0, or the TimerWheel arguments are invalid.
+                ShardedTimerWheel(std::size_t numShards = std::max(1u, std::thread::hardware_concurrency()),
+                                  std::chrono::microseconds tickDuration = std::chrono::milliseconds(1),
+                                  uint32_t numLevels = 4,
+                                  std::shared_ptr<Executor> executor = nullptr) :
+                        id_(GetNextId()) {
+                    if(numShards == 0)
+                        throw std::invalid_argument(std::string() + "numShards provided to " + __PRETTY_FUNCTION__ +
+                                                    " was 0.");
+
+                    for(std::size_t i = 0; i < numShards; i++)
+                        shards_.push_back(std::unique_ptr<TimerWheel>(new TimerWheel(tickDuration, numLevels, executor)));
+                }
+
+                ShardedTimerWheel(const ShardedTimerWheel&) = delete;
+                ShardedTimerWheel& operator=(const ShardedTimerWheel&) = delete;
+
+                /// \brief      Call to add a new single-shot timer to the shard owned by the calling thread.
+                /// \returns    A handle to the newly created timer.
+                /// \note       Thread-safe and re-entrant.
+                template<typename F>
+                ShardedTimerHandle AddSingleShotTimer(std::chrono::microseconds duration, F&& onExpiry,
+                                                      std::chrono::microseconds slack = std::chrono::microseconds(0)) {
+                    auto shard = GetThreadShard();
+                    return ShardedTimerHandle(shard, shards_[shard]->AddSingleShotTimer(duration, std::forward<F>(onExpiry), slack));
+                }
+
+                /// \brief      Call to add a new repetitive timer to the shard owned by the calling thread.
+                /// \returns    A handle to the newly created timer.
+                /// \note       Thread-safe and re-entrant.
+                template<typename F>
+                ShardedTimerHandle AddRepetitiveTimer(std::chrono::microseconds duration, int64_t numRepetitions, F&& onExpiry,
+                                                      std::chrono::microseconds slack = std::chrono::microseconds(0),
+                                                      MissedTickPolicy missedTickPolicy = MissedTickPolicy::Skip) {
+                    auto shard = GetThreadShard();
+                    return ShardedTimerHandle(shard, shards_[shard]->AddRepetitiveTimer(duration, numRepetitions,
+                                                                                        std::forward<F>(onExpiry), slack,
+                                                                                        missedTickPolicy));
+                }
+
+                /// \brief      Call to remove a timer. Only the shard that owns the timer is touched.
+                /// \returns    True is timer was found (and removed), otherwise false.
+                /// \note       Thread-safe and re-entrant. Can be called from any thread, not just the one that added
+                ///             the timer.
+                bool RemoveTimer(ShardedTimerHandle timerHandle) {
+                    if(timerHandle.shard_ >= shards_.size())
+                        return false;
+                    return shards_[timerHandle.shard_]->RemoveTimer(timerHandle.timerHandle_);
+                }
+
+                /// \brief      Call to restart a timer, see TimerWheel::RestartTimer(). Only the shard that owns the timer
+                ///             is touched.
+                /// \returns    True if the timer was found (and restarted), otherwise false.
+                /// \note       Thread-safe and re-entrant. Can be called from any thread, not just the one that added
+                ///             the timer.
+                bool RestartTimer(ShardedTimerHandle timerHandle, std::chrono::microseconds newDuration) {
+                    if(timerHandle.shard_ >= shards_.size())
+                        return false;
+                    return shards_[timerHandle.shard_]->RestartTimer(timerHandle.timerHandle_, newDuration);
+                }
+
+                /// \returns    See TimerWheel::GetNumMissedTicks().
+                /// \note       Thread-safe and re-entrant.
+                uint64_t GetNumMissedTicks(ShardedTimerHandle timerHandle) const {
+                    if(timerHandle.shard_ >= shards_.size())
+                        return 0;
+                    return shards_[timerHandle.shard_]->GetNumMissedTicks(timerHandle.timerHandle_);
+                }
+
+                /// \brief      Call to add a batch of timers to the shard owned by the calling thread, see
+                ///             TimerWheel::AddTimers(). The whole batch is pushed onto the shard's inbox at once.
+                /// \note       Thread-safe and re-entrant.
+                template<typename ForwardIt, typename OutputIt>
+                OutputIt AddTimers(ForwardIt first, ForwardIt last, OutputIt timerHandles) {
+                    auto shard = GetThreadShard();
+                    std::vector<TimerHandle> shardTimerHandles;
+                    shardTimerHandles.reserve(static_cast<std::size_t>(std::distance(first, last)));
+                    shards_[shard]->AddTimers(first, last, std::back_inserter(shardTimerHandles));
+                    for(auto& timerHandle : shardTimerHandles)
+                        *timerHandles++ = ShardedTimerHandle(shard, timerHandle);
+                    return timerHandles;
+                }
+
+                /// \brief      Call to remove a batch of timers. The handles are grouped by shard, and the timers owned by
+                ///             each shard are pushed onto it's cancel inbox at once.
+                /// \returns    The number of timers that were found (and removed).
+                /// \note       Thread-safe and re-entrant.
+                template<typename InputIt>
+                std::size_t RemoveTimers(InputIt first, InputIt last) {
+                    std::vector<std::vector<TimerHandle>> timerHandlesPerShard(shards_.size());
+                    for(; first != last; ++first) {
+                        if(first->shard_ < shards_.size())
+                            timerHandlesPerShard[first->shard_].push_back(first->timerHandle_);
+                    }
+
+                    std::size_t numRemoved = 0;
+                    for(std::size_t shard = 0; shard < shards_.size(); shard++) {
+                        auto& timerHandles = timerHandlesPerShard[shard];
+                        if(!timerHandles.empty())
+                            numRemoved += shards_[shard]->RemoveTimers(timerHandles.begin(), timerHandles.end());
+                    }
+                    return numRemoved;
+                }
+
+                /// \returns    The total number of wakeups saved by coalescing timers with slack, across all shards.
+                uint64_t GetNumWakeupsSaved() const {
+                    uint64_t numWakeupsSaved = 0;
+                    for(auto& shard : shards_)
+                        numWakeupsSaved += shard->GetNumWakeupsSaved();
+                    return numWakeupsSaved;
+                }
+
+                /// \returns    The statistics of all shards combined, see TimerWheel::GetStats().
+                /// \note       Thread-safe and re-entrant.
+                TimerWheelStats GetStats() const {
+                    auto stats = shards_[0]->GetStats();
+                    for(std::size_t shard = 1; shard < shards_.size(); shard++)
+                        stats += shards_[shard]->GetStats();
+                    return stats;
+                }
+
+                /// \returns    The number of shards.
+                std::size_t GetNumShards() const {
+                    return shards_.size();
+                }
+
+            private:
+
+                /// \brief      The number of ShardedTimerWheels each thread remembers it's shard for. A thread adding
+                ///             timers to more ShardedTimerWheels than this in turn may be given a new shard when it comes
+                ///             back to one, which only costs the affinity, as handles remember their shard.
+                static constexpr uint32_t THREAD_SHARD_CACHE_SIZE = 4;
+
+                /// \brief      The shard a thread was given by the ShardedTimerWheel with the given ID.
+                struct ThreadShard {
+                    uint64_t wheelId_ = 0;
+                    uint32_t shard_ = 0;
+                };
+
+                /// \returns    The shard that the calling thread adds it's timers to. Shards are handed out in round-robin
+                ///             order, the first time each thread adds a timer to this ShardedTimerWheel.
+                uint32_t GetThreadShard() {
+                    static thread_local ThreadShard threadShards[THREAD_SHARD_CACHE_SIZE];
+                    static thread_local uint32_t nextThreadShard = 0;
+                    for(auto& threadShard : threadShards) {
+                        if(threadShard.wheelId_ == id_)
+                            return threadShard.shard_;
+                    }
+
+                    auto& threadShard = threadShards[nextThreadShard++ % THREAD_SHARD_CACHE_SIZE];
+                    threadShard.wheelId_ = id_;
+                    threadShard.shard_ = static_cast<uint32_t>(nextShard_.fetch_add(1, std::memory_order_relaxed) %
+                                                               shards_.size());
+                    return threadShard.shard_;
+                }
+
+                /// \returns    A new ID, unique to one ShardedTimerWheel for the life of the process. IDs start at 1, so
+                ///             an empty ThreadShard never matches.
+                static uint64_t GetNextId() {
+                    static std::atomic<uint64_t> nextId(1);
+                    return nextId.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                const uint64_t id_;
+                std::atomic<std::size_t> nextShard_{0};
+                std::vector<std::unique_ptr<TimerWheel>> shards_;
+            };
+        } // namespace TimerWheel
+    } // namespace CppUtils
+} // namespace mn
+
+
+#endif // MN_CPP_UTILS_SHARDED_TIMER_WHEEL_H_
@@ -0,0 +1,97 @@
+///
+/// \file 				StaticEvent.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the StaticEvent class.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_STATIC_EVENT_H_
+#define MN_CPP_UTILS_STATIC_EVENT_H_
+
+// System includes
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// User includes
+#include "Event.hpp"
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      An event whose listeners are fixed at compile time, for wiring which never changes at run time.
+        /// \details    The listeners are the template parameters (any callable types, e.g. functors or lambdas), and
+        ///             are stored by value in a tuple. Fire() calls each one directly, so there is no type erasure,
+        ///             no indirect call and no heap, and the compiler can inline the whole fan-out.
+        ///             Listeners which are default constructible can be given as a type list, e.g.
+        ///             StaticEvent<UpdateStats, LogPacket> event;. Lambdas (or listeners with state) are given to the
+        ///             constructor, most easily through MakeStaticEvent().
+        template<typename ...Listeners>
+        class StaticEvent {
+        public:
+
+            StaticEvent() = default;
+
+            /// \brief      Creates the event from the given listeners, one for each template parameter.
+            template<typename First, typename ...Rest, typename = typename std::enable_if<
+                    !std::is_same<typename std::decay<First>::type, StaticEvent>::value>::type>
+            explicit StaticEvent(First&& first, Rest&&... rest) :
+                    listeners_(std::forward<First>(first), std::forward<Rest>(rest)...) {}
+
+            /// \brief      Calls every listener, in the order they were given, with the given parameters.
+            /// \details    Parameters are passed the same way as Event::Fire(), every listener gets them as lvalues
+            ///             except the last, which gets them forwarded (see CallListener()).
+            template <class ...Arg>
+            void Fire(Arg&&... parameters) {
+                FireImpl(std::index_sequence_for<Listeners...>(), std::forward<Arg>(parameters)...);
+            }
+
+            /// \returns    The number of listeners.
+            static constexpr std::size_t GetNumListeners() {
+                return sizeof...(Listeners);
+            }
+
+            /// \returns    The listener at the given index, to reach it's state.
+            template<std::size_t I>
+            typename std::tuple_element<I, std::tuple<Listeners...>>::type& GetListener() {
+                return std::get<I>(listeners_);
+            }
+
+        private:
+
+            template<std::size_t ...I, class ...Arg>
+            void FireImpl(std::index_sequence<I...>, Arg&&... parameters) {
+                // A braced list is evaluated left to right, which gives the call order
+                using Expand = int[];
+                (void)Expand{ 0, (Call<I>(std::integral_constant<bool, I + 1 == sizeof...(Listeners)>(),
+                                          std::forward<Arg>(parameters)...), 0)... };
+            }
+
+            template<std::size_t I, class ...Arg>
+            void Call(std::false_type /* isLast */, Arg&&... parameters) {
+                CallListener(std::get<I>(listeners_), std::forward<Arg>(parameters)...);
+            }
+
+            template<std::size_t I, class ...Arg>
+            void Call(std::true_type /* isLast */, Arg&&... parameters) {
+                CallLastListener(std::get<I>(listeners_), std::forward<Arg>(parameters)...);
+            }
+
+            std::tuple<Listeners...> listeners_;
+        };
+
+        /// \brief      Creates a StaticEvent from the given listeners, so their types (e.g. of lambdas) do not have to
+        ///             be named.
+        template<typename ...Listeners>
+        StaticEvent<typename std::decay<Listeners>::type...> MakeStaticEvent(Listeners&&... listeners) {
+            return StaticEvent<typename std::decay<Listeners>::type...>(std::forward<Listeners>(listeners)...);
+        }
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_STATIC_EVENT_H_
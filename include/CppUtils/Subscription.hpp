@@ -0,0 +1,118 @@
+///
+/// \file 				Subscription.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the ListenerId and Subscription classes.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_SUBSCRIPTION_H_
+#define MN_CPP_UTILS_SUBSCRIPTION_H_
+
+// System includes
+#include <cstdint>
+#include <utility>
+
+namespace mn {
+    namespace CppUtils {
+
+        /// \brief      Identifies a listener attached to an Event or ConcurrentEvent. Returned by AddListener(), and
+        ///             given back to RemoveListener(). Stays valid (and unique) while other listeners are added and
+        ///             removed.
+        class ListenerId {
+        public:
+
+            /// \brief      Creates an ID which does not identify any listener.
+            ListenerId() {}
+
+            explicit ListenerId(uint64_t value) : value_(value) {}
+
+            uint64_t GetValue() const {
+                return value_;
+            }
+
+            bool operator==(const ListenerId& rhs) const {
+                return value_ == rhs.value_;
+            }
+
+            bool operator!=(const ListenerId& rhs) const {
+                return value_ != rhs.value_;
+            }
+
+        private:
+            uint64_t value_ = UINT64_MAX;
+        };
+
+        /// \brief      Removes a listener from it's event when destroyed (RAII). Returned by Event::Subscribe() and
+        ///             ConcurrentEvent::Subscribe().
+        /// \details    Works with any event type, so subscriptions to different events can be kept together (e.g. in
+        ///             a std::vector<Subscription> member, which unsubscribes from everything when the owner is
+        ///             destroyed). The event must outlive the Subscription.
+        ///             This class is movable but not copyable.
+        class Subscription {
+        public:
+
+            /// \brief      Creates a Subscription which is not subscribed to anything.
+            Subscription() {}
+
+            template<typename EventType>
+            Subscription(EventType& event, ListenerId listenerId) :
+                    event_(&event),
+                    listenerId_(listenerId),
+                    removeListener_([](void* event, ListenerId listenerId) {
+                        static_cast<EventType*>(event)->RemoveListener(listenerId);
+                    }) {}
+
+            Subscription(const Subscription&) = delete;
+            Subscription& operator=(const Subscription&) = delete;
+
+            Subscription(Subscription&& other) noexcept {
+                *this = std::move(other);
+            }
+
+            Subscription& operator=(Subscription&& other) noexcept {
+                if(this != &other) {
+                    Unsubscribe();
+                    event_ = other.event_;
+                    listenerId_ = other.listenerId_;
+                    removeListener_ = other.removeListener_;
+                    other.event_ = nullptr;
+                }
+                return *this;
+            }
+
+            ~Subscription() {
+                Unsubscribe();
+            }
+
+            /// \brief      Removes the listener from the event now, rather than on destruction. Does nothing if
+            ///             already unsubscribed.
+            void Unsubscribe() {
+                if(event_ == nullptr)
+                    return;
+                removeListener_(event_, listenerId_);
+                event_ = nullptr;
+            }
+
+            /// \returns    True if the listener is still attached by this Subscription.
+            bool IsSubscribed() const {
+                return event_ != nullptr;
+            }
+
+            /// \returns    The ID of the listener.
+            ListenerId GetListenerId() const {
+                return listenerId_;
+            }
+
+        private:
+            void* event_ = nullptr;
+            ListenerId listenerId_;
+            void (*removeListener_)(void*, ListenerId) = nullptr;
+        };
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_SUBSCRIPTION_H_
@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-08-09
-/// \last-modified		2017-10-06
+/// \last-modified		2026-10-17
 /// \brief 				Contains the ThreadSafeQueue class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -16,12 +16,15 @@
 #include <mutex>
 #include <condition_variable>
 
+// User includes
+#include "WaitSet.hpp"
+
 namespace mn {
     namespace CppUtils {
 
         /// \brief       A thread-safe queue designed for inter-thread communication.
         template<typename T>
-        class ThreadSafeQueue {
+        class ThreadSafeQueue : public Waitable {
         public:
 
             /// \brief      Adds something to the back of the thread-safe queue.
@@ -32,6 +35,7 @@ namespace mn {
 
                 // Push item onto queue
                 queue_.push(item);
+                NotifyWaitSets();
 
                 // IMPORTANT: This has to be done BEFORE conditional variable is notified
                 uniqueLock.unlock();
@@ -88,6 +92,12 @@ namespace mn {
                 return queue_.size();
             }
 
+            /// \returns    True if Pop() would not block right now (i.e. the queue is not empty). Used by WaitSet.
+            bool IsReady() {
+                std::unique_lock<std::mutex> uniqueLock(mutex_);
+                return !queue_.empty();
+            }
+
         private:
 
             std::queue<T> queue_;
@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-06
-/// \last-modified		2017-10-06
+/// \last-modified		2026-10-17
 /// \brief 				Contains the Timer class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -12,54 +12,77 @@
 #define MN_CPP_UTILS_TIMER_H_
 
 // System includes
-#include <mutex>
-#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
+// User includes
+#include "Executor.hpp"
 #include "Semaphore.hpp"
+#include "TimerWheel.hpp"
 
 namespace mn {
     namespace CppUtils {
 
         /// \brief      A class that can be used to schedule timed operations.
-        /// \details    Timer is stopped and timer thread joined on destruction.
+        /// \details    All Timers share one TimerWheel thread, and the callbacks are run on a small shared pool of
+        ///             threads, so a Timer is only a handle to a timer in the wheel. Creating and destroying one costs
+        ///             a few atomic operations rather than a thread spawn and join.
+        ///             The timer is stopped on destruction. If the callback has already started, the destructor blocks
+        ///             until it has returned, so the callback never outlives the Timer.
+        ///             The shared TimerWheel is created on first use and never destroyed, so a Timer can be a static
+        ///             or global object, or be destroyed from another static object's destructor, at any point
+        ///             during program exit.
+        ///             This class is neither movable nor copyable.
+        /// \warning    Do not destroy a Timer from within it's own callback, this deadlocks.
         class Timer {
         public:
 
-            Timer(std::chrono::milliseconds duration, std::function<void()> callback) {
-
-                duration_ = duration;
-                callback_ = callback;
-
-                t_ = std::thread([this]() {
-                    if(semaphore_.TryWait(duration_)) {
-                        // We got a notification, which means someone wishes to stop the timer
-                        // before the timeout occured.
-                        return;
-                    } else {
-                        // We waited and got no notification, which means the timer must of expired!
-                        // That means we can call the callback
-                        callback_();
-                    }
+            /// \brief      Starts the timer.
+            /// \param[in]  duration    The time from now until the callback is called.
+            /// \param[in]  callback    Called once the duration has passed, on one of the shared timer threads.
+            /// \throws     std::invalid_argument if the duration is negative or the callback is empty.
+            Timer(std::chrono::milliseconds duration, std::function<void()> callback) :
+                    callback_(std::move(callback)) {
+                if(!callback_)
+                    throw std::invalid_argument(std::string() + "callback provided to " + __PRETTY_FUNCTION__ +
+                                                " does not have a valid object to call.");
 
+                timerHandle_ = GetScheduler().AddSingleShotTimer(duration, [this]() {
+                    callback_();
+                    finished_.Notify();
                 });
             }
 
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+
             ~Timer() {
-                // Tell the timer thread we wish to quit!
-                semaphore_.Notify();
-                if(t_.joinable())
-                    t_.join();
+                // If the timer is removed before it expires, the callback will never be called. Otherwise it has
+                // already been called, or is being called right now, so wait for it to return
+                if(!GetScheduler().RemoveTimer(timerHandle_))
+                    finished_.Wait();
             }
 
-
         private:
-            std::thread t_;
-            std::chrono::milliseconds duration_;
+
+            /// \returns    The TimerWheel shared by all Timers. It (and it's thread pool) is created on first use.
+            /// \details    Deliberately leaked, rather than a function-local static object, as a static object would
+            ///             be destroyed during program exit while static or global Timers created after it may still
+            ///             be using it.
+            static TimerWheel::TimerWheel& GetScheduler() {
+                static auto scheduler = new TimerWheel::TimerWheel(std::chrono::milliseconds(1), 4,
+                                                                   std::make_shared<ThreadPoolExecutor>());
+                return *scheduler;
+            }
+
             std::function<void()> callback_;
+            TimerWheel::TimerHandle timerHandle_;
 
-            /// \brief      This semaphore is used to both block until timer timeout occurs, OR
-            ///             to notify timer thread when timer is stopped (usually due to destructor being called).
-            Semaphore semaphore_;
+            /// \brief      Notified once the callback has returned.
+            Semaphore finished_;
         };
     } // namespace CppUtils
 } // namespace mn
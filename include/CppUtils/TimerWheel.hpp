@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-16
-/// \last-modified		2017-10-18
+/// \last-modified		2026-10-17
 /// \brief 				Contains the TimerWheel class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -12,14 +12,34 @@
 #define MN_CPP_UTILS_TIMER_WHEEL_H_
 
 // System includes
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <mutex>
 #include <condition_variable>
-#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
 
 // User includes
-// nothing
+#include "Executor.hpp"
+#include "InlineFunction.hpp"
+#include "Log2Histogram.hpp"
 
 namespace mn {
     namespace CppUtils {
@@ -31,327 +51,1887 @@ namespace mn {
             enum class TimerState {
                 Initialized,    // Default state timer is in before it is added to the TimerWheel
                 Running,        // Timer transitions to this state when added to the TimerWheel
-                Finished        // Timer is in this state if it is a single-shot timer and it has timed-out,
+                Finished,       // Timer is in this state if it is a single-shot timer and it has timed-out,
                                 // or it is a repetitive timer and it has done the specified number of repeats.
+                Cancelled       // Timer has been removed from the TimerWheel before it finished
+            };
+
+            enum class TimerType {
+                SingleShot,     // Timer expires once and is then finished
+                Repetitive      // Timer is re-inserted into the wheel every time it expires
+            };
+
+            /// \brief      What a repetitive timer does when it expires so late that one or more of it's next deadlines
+            ///             have already passed (e.g. because the timer wheel thread was busy in a slow callback).
+            enum class MissedTickPolicy {
+                Skip,           // The missed deadlines are dropped, and the timer carries on from the next deadline
+                                // that is still in the future, keeping it's original phase
+                Burst,          // The timer is called once for every missed deadline, on consecutive ticks, until it
+                                // has caught up
+                FireOnce        // The timer is called once for all the missed deadlines, and the next deadline is one
+                                // period after the (late) time it was called
             };
 
-            /// \brief      Abstract base class that represents a timer.
-            /// \details    This is inherited by SingleShotTimer and RepetitiveTimer.
+            /// \brief      A timer node. Timers are created and owned by a TimerWheel, which keeps them in a pool and
+            ///             re-uses them once they have expired or been removed.
+            /// \details    The onExpiry callback is stored inline in the node (as long as it fits in
+            ///             CALLBACK_CAPACITY bytes), and the node is linked into the wheel through intrusive list
+            ///             hooks, so adding, expiring and removing a timer does not allocate. What kind of timer
+            ///             this is is given by a TimerType tag, rather than by a derived class.
             class Timer {
             public:
 
                 // Declare the TimerWheel class as a friend. This allows the TimerWheel to access the timer's data
-                // without having to call the public functions, which lock a mutex.
+                // without having to call the public functions.
                 friend TimerWheel;
 
-                virtual ~Timer() {}
+                /// \brief      Callbacks up to this size (in bytes) are stored inline in the timer. Larger callbacks
+                ///             are still supported, but are allocated on the heap.
+                static constexpr std::size_t CALLBACK_CAPACITY = 48;
 
-                const std::chrono::milliseconds& GetDuration() const {
+                using Callback = InlineFunction<void(), CALLBACK_CAPACITY>;
+
+                TimerType GetType() const {
+                    return type_;
+                }
+
+                const std::chrono::microseconds& GetDuration() const {
                     return duration_;
                 }
 
-                const std::chrono::high_resolution_clock::time_point& GetStartTime() {
+                const std::chrono::steady_clock::time_point& GetStartTime() {
                     return startTime_;
                 }
 
 
-                void SetStartTime(std::chrono::high_resolution_clock::time_point startTime) {
+                void SetStartTime(std::chrono::steady_clock::time_point startTime) {
                     startTime_ = startTime;
                 }
 
-            protected:
+            private:
+
+                Timer() {}
+
+                //==============================================//
+                //================ TIMER SETUP =================//
+                //==============================================//
+                // The following variables are written by the thread that adds the timer, before it is pushed
+                // onto the TimerWheel's inbox, and only read after that.
+
+                TimerType type_ = TimerType::SingleShot;
+
+                std::chrono::microseconds duration_{0};
+
+                /// \brief      How late the timer is allowed to expire. The TimerWheel uses this to group timers with
+                ///             nearby expiry times together so they expire on the same wakeup.
+                std::chrono::microseconds slack_{0};
+
+                /// \brief      Only used by repetitive timers. The number of times the timer still has to be called, or
+                ///             -1 to repeat forever. Once the timer has been drained from the add inbox, this is
+                ///             owned by the timer wheel thread, which counts it down.
+                int64_t numRepetitions_ = 0;
+
+                /// \brief      Only used by repetitive timers.
+                MissedTickPolicy missedTickPolicy_ = MissedTickPolicy::Skip;
+
+                std::chrono::steady_clock::time_point startTime_;
+                Callback onExpiry_;
+
+                /// \brief      Only used with a manual clock, where timers which expire on the same tick with the same
+                ///             deadline are called in the order they were added.
+                uint64_t seq_ = 0;
+
+                //==============================================//
+                //============== SHARED BETWEEN THREADS ========//
+                //==============================================//
+
+                /// \brief      The generation (upper 32 bits) and TimerState (lower 32 bits) of the timer. These are kept
+                ///             in one atomic so a TimerHandle can be checked and the timer removed with a single
+                ///             compare-and-swap. The generation is incremented every time the timer expires (if
+                ///             single-shot) or is removed, so that old handles to it become invalid. Generations start
+                ///             at 1, so a generation of 0 is never valid.
+                std::atomic<uint64_t> control_{uint64_t(1) << 32};
+
+                /// \brief      One reference is held by the TimerWheel while the timer is running, plus one for every
+                ///             onExpiry callback that has been scheduled but has not finished yet. The timer is
+                ///             returned to the pool when this drops to 0, so the callback stays valid while it is
+                ///             running.
+                std::atomic<uint32_t> refCount_{0};
+
+                /// \brief      The number of deadlines of this (repetitive) timer that were missed and not called, see
+                ///             TimerWheel::GetNumMissedTicks(). Only written by the timer wheel thread.
+                std::atomic<uint64_t> numMissedTicks_{0};
+
+                /// \brief      The index of the next timer in the pool's free list, only valid while this timer is free.
+                std::atomic<uint32_t> nextFree_{UINT32_MAX};
+
+                /// \brief      The time (as Clock::rep) and new duration (in microseconds) given to the last call to
+                ///             TimerWheel::RestartTimer(). Only read by the timer wheel thread when it drains the
+                ///             restart.
+                std::atomic<std::chrono::steady_clock::rep> restartTime_{0};
+                std::atomic<int64_t> restartDuration_{0};
+
+                /// \brief      Links for the TimerWheel's add, cancel and restart inboxes. These are separate, as a timer
+                ///             can be in all of them at once (e.g. if it is restarted and then removed before the timer
+                ///             wheel thread has drained it's add).
+                Timer* addNext_ = nullptr;
+                Timer* cancelNext_ = nullptr;
+                Timer* restartNext_ = nullptr;
+
+                /// \brief      The index of this timer in the TimerWheel's pool. Set once when the pool is grown.
+                uint32_t index_ = 0;
+
+                //==============================================//
+                //========= TIMER WHEEL BOOKKEEPING ============//
+                //==============================================//
+                // The following variables are owned by the timer wheel thread once it has drained the timer from
+                // the add inbox (the expiry ticks are first calculated by the thread adding the timer).
+
+                /// \brief      The wheel tick on which this timer is due to expire, ignoring slack.
+                uint64_t deadlineTick_ = 0;
+
+                /// \brief      The wheel tick on which this timer will actually expire. This is somewhere between
+                ///             deadlineTick_ and deadlineTick_ + slack_.
+                uint64_t expiryTick_ = 0;
+
+                /// \brief      The wheel level and slot this timer is currently linked into.
+                uint32_t level_ = 0;
+                uint32_t slot_ = 0;
+
+                /// \brief      True while the timer is linked into a slot of the wheel.
+                bool linked_ = false;
+
+                /// \brief      Set once the timer wheel thread has drained the timer from the cancel inbox. If a restart
+                ///             of the timer was still pending then, the wheel's reference is released when the restart
+                ///             is drained instead.
+                bool cancelDrained_ = false;
+
+                /// \brief      Intrusive list hooks, the timers in a slot form a doubly-linked list so that
+                ///             they can be linked and unlinked in O(1) without any extra allocations.
+                Timer* prev_ = nullptr;
+                Timer* next_ = nullptr;
+            };
+
+            /// \brief      A handle to a timer that has been added to a TimerWheel.
+            /// \details    A handle points directly at the timer's node in the TimerWheel's pool, so the timer can be
+            ///             found in O(1). Each node has a generation count which is incremented every time the
+            ///             node is finished with, and a handle is only valid while it's generation matches the node's.
+            ///             This means a handle to a timer which has already expired (or been removed) can never
+            ///             refer to a new timer which happens to re-use the same node.
+            ///             A default constructed handle never refers to a timer.
+            class TimerHandle {
+            public:
+
+                friend TimerWheel;
+
+                TimerHandle() {}
+
+                bool operator==(const TimerHandle& rhs) const {
+                    return index_ == rhs.index_ && generation_ == rhs.generation_;
+                }
+
+                bool operator!=(const TimerHandle& rhs) const {
+                    return !(*this == rhs);
+                }
 
-                /// \throws     std::invalid_argument if duration is negative, OR onExpiry does not have an object to
-                ///             call (i.e. equates to false).
-                Timer(std::chrono::milliseconds duration, std::function<void()> onExpiry) :
+            private:
+
+                TimerHandle(uint32_t index, uint32_t generation) :
+                        index_(index),
+                        generation_(generation) {}
+
+                uint32_t index_ = 0;
+
+                /// \brief      Timer generations start at 1, so a generation of 0 is never valid.
+                uint32_t generation_ = 0;
+            };
+
+            /// \brief      Describes a timer to add to a TimerWheel with TimerWheel::AddTimers(). Create with
+            ///             SingleShot() or Repetitive(), which take the same arguments as
+            ///             TimerWheel::AddSingleShotTimer() and TimerWheel::AddRepetitiveTimer().
+            ///             This class is movable but not copyable.
+            class TimerSpec {
+            public:
+
+                friend TimerWheel;
+
+                template<typename F>
+                static TimerSpec SingleShot(std::chrono::microseconds duration, F&& onExpiry,
+                                            std::chrono::microseconds slack = std::chrono::microseconds(0)) {
+                    return TimerSpec(TimerType::SingleShot, duration, 0, Timer::Callback(std::forward<F>(onExpiry)), slack,
+                                     MissedTickPolicy::Skip);
+                }
+
+                template<typename F>
+                static TimerSpec Repetitive(std::chrono::microseconds duration, int64_t numRepetitions, F&& onExpiry,
+                                            std::chrono::microseconds slack = std::chrono::microseconds(0),
+                                            MissedTickPolicy missedTickPolicy = MissedTickPolicy::Skip) {
+                    return TimerSpec(TimerType::Repetitive, duration, numRepetitions,
+                                     Timer::Callback(std::forward<F>(onExpiry)), slack, missedTickPolicy);
+                }
+
+            private:
+
+                TimerSpec(TimerType type, std::chrono::microseconds duration, int64_t numRepetitions,
+                          Timer::Callback&& onExpiry, std::chrono::microseconds slack, MissedTickPolicy missedTickPolicy) :
+                        type_(type),
                         duration_(duration),
-                        onExpiry_(onExpiry) {
-                    // Input argument checks
-                    if(duration_.count() < 0)
-                        throw std::invalid_argument(std::string() + "The value of duration \"" +
-                                                    std::to_string(duration_.count()) + "ms\" provided to "
-                                                    + __PRETTY_FUNCTION__ + " was negative.");
+                        numRepetitions_(numRepetitions),
+                        onExpiry_(std::move(onExpiry)),
+                        slack_(slack),
+                        missedTickPolicy_(missedTickPolicy) {}
 
-                    if(!onExpiry_)
-                        throw std::invalid_argument(std::string() + "onExpiry provided to " + __PRETTY_FUNCTION__ +
-                                                            " does not have a valid object to call.");
+                TimerType type_;
+                std::chrono::microseconds duration_;
+                int64_t numRepetitions_;
+                Timer::Callback onExpiry_;
+                std::chrono::microseconds slack_;
+                MissedTickPolicy missedTickPolicy_;
+            };
+
+            /// \brief      A source of time for a TimerWheel. By default a TimerWheel reads std::chrono::steady_clock,
+            ///             derive from this to give it a different notion of "now".
+            /// \details    The timer wheel thread sleeps in real time, so a clock given to a TimerWheel must move at the
+            ///             same rate as std::chrono::steady_clock (e.g. one with an offset). The exception is a
+            ///             ManualClock, which makes the TimerWheel run without a thread, and only move forward when
+            ///             TimerWheel::AdvanceTo() is called.
+            class ClockSource {
+            public:
+
+                virtual ~ClockSource() {}
+
+                /// \returns    The current time.
+                /// \note       Must be thread-safe, it is called both by threads adding timers and by the timer wheel.
+                virtual std::chrono::steady_clock::time_point Now() const = 0;
+            };
+
+            /// \brief      A clock which only moves when it is told to. Give one to a TimerWheel to run it in virtual
+            ///             time, e.g. for simulations (or tests) which need to run faster than real time.
+            class ManualClock : public ClockSource {
+            public:
 
+                /// \param[in]  startTime   The time the clock starts at.
+                explicit ManualClock(std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::time_point()) :
+                        time_(startTime.time_since_epoch().count()) {}
+
+                std::chrono::steady_clock::time_point Now() const override {
+                    return std::chrono::steady_clock::time_point(
+                            std::chrono::steady_clock::duration(time_.load(std::memory_order_acquire)));
                 }
 
-                std::chrono::milliseconds duration_;
+                /// \brief      Sets the current time. Normally this is only called by TimerWheel::AdvanceTo().
+                /// \note       Thread-safe and re-entrant.
+                void SetTime(std::chrono::steady_clock::time_point time) {
+                    time_.store(time.time_since_epoch().count(), std::memory_order_release);
+                }
 
-                std::chrono::high_resolution_clock::time_point startTime_;
-                std::function<void()> onExpiry_;
-                TimerState state_;
+            private:
+                std::atomic<std::chrono::steady_clock::rep> time_;
             };
 
-            class SingleShotTimer : public Timer {
+            /// \brief      A snapshot of the statistics of a TimerWheel, returned by TimerWheel::GetStats().
+            class TimerWheelStats {
             public:
-                SingleShotTimer(std::chrono::milliseconds duration, std::function<void()> onExpiry) :
-                        Timer(duration, onExpiry) {
 
+                friend TimerWheel;
+
+                /// \returns    A histogram of how late timer callbacks were started compared to the timers' deadlines,
+                ///             in nanoseconds. With an executor, this is measured when the callback is handed to
+                ///             the executor (so does not include the time spent in the executor's queue).
+                const Log2HistogramSnapshot& GetLateness() const {
+                    return lateness_;
+                }
+
+                /// \returns    A histogram of how long timer callbacks took to run, in nanoseconds.
+                const Log2HistogramSnapshot& GetCallbackDuration() const {
+                    return callbackDuration_;
+                }
+
+                /// \returns    The number of timers linked into the wheel (i.e. running timers, minus any that are still
+                ///             in the add inbox).
+                std::size_t GetNumTimers() const {
+                    return numTimers_;
+                }
+
+                /// \returns    The number of timers linked into each level of the wheel.
+                const std::vector<std::size_t>& GetNumTimersInLevel() const {
+                    return numTimersInLevel_;
+                }
+
+                /// \returns    The number of times the timer wheel thread has woken up.
+                uint64_t GetNumWakeups() const {
+                    return numWakeups_;
+                }
+
+                /// \returns    See TimerWheel::GetNumWakeupsSaved().
+                uint64_t GetNumWakeupsSaved() const {
+                    return numWakeupsSaved_;
                 }
+
+                /// \returns    The total number of deadlines of repetitive timers which were missed (and not called), see
+                ///             TimerWheel::GetNumMissedTicks(). If this keeps growing, the wheel is not keeping up.
+                uint64_t GetNumMissedTicks() const {
+                    return numMissedTicks_;
+                }
+
+                /// \returns    The average number of wakeups per second of the timer wheel thread since the TimerWheel
+                ///             was created.
+                double GetWakeupsPerSecond() const {
+                    return GetRate(numWakeups_, time_ - startTime_);
+                }
+
+                /// \returns    The average number of wakeups per second of the timer wheel thread between an earlier
+                ///             snapshot and this one.
+                double GetWakeupsPerSecond(const TimerWheelStats& previous) const {
+                    return GetRate(numWakeups_ - previous.numWakeups_, time_ - previous.time_);
+                }
+
+                /// \returns    The total time threads have spent waiting for the TimerWheel's locks (to grow the timer
+                ///             pool, or to count the callbacks given to the executor). Adding and removing timers is
+                ///             otherwise lock-free, so this should stay close to 0.
+                std::chrono::nanoseconds GetLockWaitTime() const {
+                    return lockWaitTime_;
+                }
+
+                /// \returns    When the snapshot was taken.
+                std::chrono::steady_clock::time_point GetTime() const {
+                    return time_;
+                }
+
+                /// \brief      Adds the statistics of another TimerWheel to this one, e.g. to combine the statistics of
+                ///             several shards. The wakeup rate stays based on the times of this snapshot.
+                TimerWheelStats& operator+=(const TimerWheelStats& rhs) {
+                    lateness_ += rhs.lateness_;
+                    callbackDuration_ += rhs.callbackDuration_;
+                    numTimers_ += rhs.numTimers_;
+                    numTimersInLevel_.resize(std::max(numTimersInLevel_.size(), rhs.numTimersInLevel_.size()), 0);
+                    for(std::size_t level = 0; level < rhs.numTimersInLevel_.size(); level++)
+                        numTimersInLevel_[level] += rhs.numTimersInLevel_[level];
+                    numWakeups_ += rhs.numWakeups_;
+                    numWakeupsSaved_ += rhs.numWakeupsSaved_;
+                    numMissedTicks_ += rhs.numMissedTicks_;
+                    lockWaitTime_ += rhs.lockWaitTime_;
+                    return *this;
+                }
+
+            private:
+
+                static double GetRate(uint64_t count, std::chrono::steady_clock::duration duration) {
+                    auto seconds = std::chrono::duration<double>(duration).count();
+                    return seconds > 0.0 ? count / seconds : 0.0;
+                }
+
+                Log2HistogramSnapshot lateness_;
+                Log2HistogramSnapshot callbackDuration_;
+                std::size_t numTimers_ = 0;
+                std::vector<std::size_t> numTimersInLevel_;
+                uint64_t numWakeups_ = 0;
+                uint64_t numWakeupsSaved_ = 0;
+                uint64_t numMissedTicks_ = 0;
+                std::chrono::nanoseconds lockWaitTime_{0};
+                std::chrono::steady_clock::time_point startTime_;
+                std::chrono::steady_clock::time_point time_;
             };
 
-            class RepetitiveTimer : public Timer {
+#ifdef __linux__
+            /// \brief      Used by the timer wheel thread to sleep until either a time point is reached, or another
+            ///             thread wakes it up.
+            /// \details    On Linux this waits on a timerfd (for the time point) and an eventfd (for Notify()) with
+            ///             epoll. The timerfd is armed with an absolute CLOCK_MONOTONIC time (the clock which
+            ///             std::chrono::steady_clock uses), so wakeups have nanosecond resolution rather than the
+            ///             millisecond resolution of a condition variable or epoll timeout.
+            ///             This class is neither movable nor copyable.
+            class Waiter {
+            public:
+
+                /// \throws     std::system_error if the file descriptors could not be created.
+                Waiter() {
+                    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+                    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+                    eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                    if(epollFd_ < 0 || timerFd_ < 0 || eventFd_ < 0) {
+                        auto error = errno;
+                        CloseFds();
+                        throw std::system_error(error, std::generic_category(),
+                                                std::string() + __PRETTY_FUNCTION__ + " failed to create file descriptors.");
+                    }
+
+                    for(auto fd : { timerFd_, eventFd_ }) {
+                        epoll_event event = {};
+                        event.events = EPOLLIN;
+                        event.data.fd = fd;
+                        if(epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+                            auto error = errno;
+                            CloseFds();
+                            throw std::system_error(error, std::generic_category(),
+                                                    std::string() + __PRETTY_FUNCTION__ + " failed to add fd to epoll.");
+                        }
+                    }
+                }
+
+                Waiter(const Waiter&) = delete;
+                Waiter& operator=(const Waiter&) = delete;
+
+                ~Waiter() {
+                    CloseFds();
+                }
+
+                /// \brief      Blocks until either the time point is reached or Notify() is called.
+                void WaitUntil(std::chrono::steady_clock::time_point timePoint) {
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+
+                    // An it_value of 0 would disarm the timer rather than expire it immediately
+                    if(ns <= 0)
+                        ns = 1;
+
+                    itimerspec spec = {};
+                    spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+                    spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+                    timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+                    EpollWait();
+                }
+
+                /// \brief      Blocks until Notify() is called.
+                void Wait() {
+                    itimerspec spec = {};
+                    timerfd_settime(timerFd_, 0, &spec, nullptr);
+                    EpollWait();
+                }
+
+                /// \brief      Wakes up the thread blocked in Wait() or WaitUntil(). If no thread is blocked, the
+                ///             next call to Wait() or WaitUntil() will return immediately.
+                /// \note       Thread-safe and re-entrant.
+                void Notify() {
+                    uint64_t value = 1;
+                    auto result = write(eventFd_, &value, sizeof(value));
+                    (void)result;
+                }
+
+                /// \brief      Reduces the timer slack of the calling thread to the minimum, so the kernel does not
+                ///             delay the thread's timerfd wakeups to group them with other wakeups (by default
+                ///             Linux allows up to 50us of slack).
+                static void MinimiseTimerSlack() {
+                    prctl(PR_SET_TIMERSLACK, 1, 0, 0, 0);
+                }
+
+            private:
+
+                void EpollWait() {
+                    epoll_event events[2];
+                    int numEvents;
+                    do {
+                        numEvents = epoll_wait(epollFd_, events, 2, -1);
+                    } while(numEvents < 0 && errno == EINTR);
+
+                    // Both fds are non-blocking, so read them both to clear them (whether they fired or not)
+                    uint64_t value;
+                    auto result = read(timerFd_, &value, sizeof(value));
+                    result = read(eventFd_, &value, sizeof(value));
+                    (void)result;
+                }
+
+                void CloseFds() {
+                    for(auto fd : { epollFd_, timerFd_, eventFd_ }) {
+                        if(fd >= 0)
+                            close(fd);
+                    }
+                }
+
+                int epollFd_ = -1;
+                int timerFd_ = -1;
+                int eventFd_ = -1;
+            };
+#else
+            /// \brief      Used by the timer wheel thread to sleep until either a time point is reached, or another
+            ///             thread wakes it up.
+            /// \details    Portable implementation using a condition variable.
+            ///             This class is neither movable nor copyable.
+            class Waiter {
             public:
 
-                RepetitiveTimer(std::chrono::milliseconds duration, int64_t numRepetitions, std::function<void()> onExpiry) :
-                        Timer(duration, onExpiry),
-                        numRepetitions_(numRepetitions) {
+                Waiter() {}
+
+                Waiter(const Waiter&) = delete;
+                Waiter& operator=(const Waiter&) = delete;
+
+                /// \brief      Blocks until either the time point is reached or Notify() is called.
+                void WaitUntil(std::chrono::steady_clock::time_point timePoint) {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait_until(lock, timePoint, [&] {
+                        return notified_;
+                    });
+                    notified_ = false;
+                }
+
+                /// \brief      Blocks until Notify() is called.
+                void Wait() {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [&] {
+                        return notified_;
+                    });
+                    notified_ = false;
+                }
+
+                /// \brief      Wakes up the thread blocked in Wait() or WaitUntil(). If no thread is blocked, the
+                ///             next call to Wait() or WaitUntil() will return immediately.
+                /// \note       Thread-safe and re-entrant.
+                void Notify() {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    notified_ = true;
+                    lock.unlock();
+                    cv_.notify_one();
+                }
+
+                static void MinimiseTimerSlack() {
                     // nothing
                 }
 
-                int64_t numRepetitions_;
+            private:
+                std::mutex mutex_;
+                std::condition_variable cv_;
+                bool notified_ = false;
             };
+#endif
 
             /// \brief      A class that can be used to schedule timed operations.
-            /// \details    Timer is stopped and timer thread joined on destruction.
+            /// \details    Timers are stored in a hierarchical hashed timing wheel (as described by Varghese and
+            ///             Lauck). Time is divided into ticks of tickDuration. Each level of the wheel has
+            ///             SLOTS_PER_LEVEL slots, level 0 slots are one tick wide, level 1 slots are SLOTS_PER_LEVEL
+            ///             ticks wide, and so on. A timer is linked into the lowest level that can hold it's
+            ///             expiry, and is cascaded down into a lower level as the wheel turns. This makes both
+            ///             inserting and expiring a timer O(1), regardless of how many timers are running.
+            ///
+            ///             The wheel itself is only ever touched by the timer wheel thread. Threads adding and
+            ///             removing timers never lock, instead they push the timer onto a lock-free add or cancel
+            ///             inbox, which the timer wheel thread drains every time it wakes up. Adding or removing a
+            ///             timer is just a few atomic operations (plus waking up the timer wheel thread, if the new
+            ///             timer expires before it was going to wake up anyway), no matter how busy the timer wheel
+            ///             thread is, even if it is in the middle of a slow callback.
+            ///
+            ///             By default callbacks are called on the timer wheel thread, but an Executor can be provided
+            ///             to hand them off to other threads instead.
+            ///
+            ///             All times are measured with std::chrono::steady_clock, so timers are not affected by changes
+            ///             to the system (wall-clock) time. Timer durations have microsecond resolution, and the
+            ///             tickDuration can be reduced below 1ms if sub-millisecond precision is needed. On Linux, the
+            ///             timer wheel thread sleeps on a timerfd, so it wakes up within tens of microseconds of the
+            ///             requested time.
+            ///
+            ///             Timers can be given some slack, which is how late they are allowed to expire. The wheel uses
+            ///             this to coalesce timers with nearby expiry times, so that they expire together on one wakeup
+            ///             of the timer wheel thread rather than waking it up separately for each one.
+            ///
+            ///             Timers are kept in a pool owned by the wheel, and each timer's callback is stored inline in
+            ///             the timer, so once the pool has grown to the peak number of timers, adding, expiring and
+            ///             removing timers does not allocate.
+            ///
+            ///             The TimerWheel can be given a ClockSource to read the time from, rather than
+            ///             std::chrono::steady_clock. With a ManualClock, there is no timer wheel thread at all. Instead
+            ///             AdvanceTo() moves the wheel forward to a given time, calling every timer that is due on the
+            ///             calling thread in a deterministic order, so simulations can run much faster than real time.
+            ///
+            ///             Timer is stopped and timer thread joined on destruction.
             class TimerWheel {
             public:
 
+                using Clock = std::chrono::steady_clock;
+
+                /// \brief      The number of slots in each level of the wheel is 2^SLOT_BITS.
+                static constexpr uint32_t SLOT_BITS = 8;
+                static constexpr uint32_t SLOTS_PER_LEVEL = 1u << SLOT_BITS;
+                static constexpr uint32_t MAX_NUM_LEVELS = 7;
+
+                /// \brief      The number of 64-bit words in the occupancy bitmap of each level.
+                static constexpr uint32_t OCCUPIED_WORDS_PER_LEVEL = SLOTS_PER_LEVEL / 64;
+
+                /// \brief      The timer pool grows in chunks of 2^POOL_CHUNK_BITS timers, up to MAX_NUM_POOL_CHUNKS
+                ///             chunks. Chunks are never freed or moved (until the TimerWheel is destroyed), so
+                ///             pointers to timers stay valid.
+                static constexpr uint32_t POOL_CHUNK_BITS = 10;
+                static constexpr uint32_t POOL_CHUNK_SIZE = 1u << POOL_CHUNK_BITS;
+                static constexpr uint32_t MAX_NUM_POOL_CHUNKS = 1u << 14;
+
+                /// \brief      The maximum number of timers that can exist at once.
+                static constexpr uint32_t MAX_NUM_TIMERS = POOL_CHUNK_SIZE * MAX_NUM_POOL_CHUNKS;
+
                 /// \brief      Creates a TimerWheel object and starts the timer wheel thread.
-                TimerWheel() {
-                    thread_ = std::thread(&TimerWheel::Process, this);
+                /// \param[in]  tickDuration    The granularity of the wheel. Timers never expire early, but may
+                ///                 expire up to one tick late.
+                /// \param[in]  numLevels       The number of levels in the wheel. The wheel can hold timers of up to
+                ///                 tickDuration * SLOTS_PER_LEVEL^numLevels without having to re-cascade them
+                ///                 (e.g. ~49 days for the default 1ms tick and 4 levels, or ~72 minutes for a 1us tick
+                ///                 and 4 levels). Longer timers are still
+                ///                 supported, they just get cascaded more than once.
+                /// \param[in]  executor        If provided, the onExpiry callbacks of expired timers are given to this
+                ///                 executor to run, and the timer wheel thread only does the bookkeeping. If not
+                ///                 provided, callbacks are called on the timer wheel thread. Note that with an executor,
+                ///                 the callbacks of a repetitive timer may run concurrently if they take longer than
+                ///                 the timer's duration.
+                /// \param[in]  clockSource     If provided, the time is read from this rather than from
+                ///                 std::chrono::steady_clock. If it is a ManualClock, no timer wheel thread is started, and
+                ///                 the wheel only moves forward when AdvanceTo() is called.
+                /// \throws     std::invalid_argument if tickDuration is not positive or numLevels is not between 1
+                ///             and MAX_NUM_LEVELS.
+                TimerWheel(std::chrono::microseconds tickDuration = std::chrono::milliseconds(1),
+                           uint32_t numLevels = 4,
+                           std::shared_ptr<Executor> executor = nullptr,
+                           std::shared_ptr<ClockSource> clockSource = nullptr) :
+                        tickDuration_(std::chrono::duration_cast<Clock::duration>(tickDuration)),
+                        numLevels_(numLevels),
+                        executor_(executor),
+                        clockSource_(clockSource),
+                        manualClock_(std::dynamic_pointer_cast<ManualClock>(clockSource)) {
+
+                    if(tickDuration.count() <= 0)
+                        throw std::invalid_argument(std::string() + "The value of tickDuration \"" +
+                                                    std::to_string(tickDuration.count()) + "us\" provided to "
+                                                    + __PRETTY_FUNCTION__ + " was not positive.");
+
+                    if(numLevels_ < 1 || numLevels_ > MAX_NUM_LEVELS)
+                        throw std::invalid_argument(std::string() + "The value of numLevels \"" +
+                                                    std::to_string(numLevels_) + "\" provided to "
+                                                    + __PRETTY_FUNCTION__ + " was not between 1 and " +
+                                                    std::to_string(MAX_NUM_LEVELS) + ".");
+
+                    slots_.resize(numLevels_ * SLOTS_PER_LEVEL, nullptr);
+                    occupiedSlots_.resize(numLevels_ * OCCUPIED_WORDS_PER_LEVEL, 0);
+                    numTimersInLevel_.resize(numLevels_, 0);
+                    // Sized like the first pool chunk, so the wheel thread does not allocate when a few more
+                    // timers than usual happen to expire on the same tick
+                    expiredTimers_.reserve(POOL_CHUNK_SIZE);
+                    deadlineTicks_.reserve(POOL_CHUNK_SIZE);
+                    poolChunks_.reset(new std::atomic<Timer*>[MAX_NUM_POOL_CHUNKS]);
+                    for(uint32_t i = 0; i < MAX_NUM_POOL_CHUNKS; i++)
+                        poolChunks_[i].store(nullptr, std::memory_order_relaxed);
+                    startTime_ = Now();
+
+                    if(manualClock_) {
+                        // There is no thread to wake up, so stop threads adding timers from trying
+                        scheduledTick_.store(0);
+                    } else {
+                        thread_ = std::thread(&TimerWheel::Process, this);
+                    }
                 }
 
-                /// \brief      Stops and joins with the timer wheel thread before destroying.
+                /// \brief      Stops and joins with the timer wheel thread before destroying. If an executor was provided,
+                ///             also blocks until all the callbacks that have been given to it have finished running.
                 ~TimerWheel() {
                     if (thread_.joinable()) {
-//                        std::cout << "Sending EXIT command and joining TimerWheel thread." << std::endl;
-
-                        //==============================================//
-                        //============ START OF SYNC BLOCK =============//
-                        //==============================================//
-                        std::unique_lock<std::mutex> lock(mutex_);
-
-                        exit_ = true;
-                        wakeup_ = true;
-                        lock.unlock();
-                        //==============================================//
-                        //============= END OF SYNC BLOCK ==============//
-                        //==============================================//
-
-//                        std::cout << "Calling notify_one()..." << std::endl;
-                        cv_.notify_one();
+                        exit_.store(true);
+                        waiter_.Notify();
                         thread_.join();
                     }
+
+                    // Callbacks given to the executor still use their timers, so wait for them to finish before the
+                    // pool is destroyed
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    executorCallbacksDone_.wait(lock, [&] {
+                        return numExecutorCallbacks_ == 0;
+                    });
                 }
 
                 /// \brief      Call to add a new single-shot timer to the timer wheel.
-                /// \returns    A unique timer ID for the newly created timer.
-                /// \note       Thread-safe and re-entrant.
-                uintptr_t AddSingleShotTimer(std::chrono::milliseconds duration, std::function<void()> onExpiry) {
-                    auto singleShotTimer = std::make_shared<SingleShotTimer>(duration, onExpiry);
-                    AddTimer(singleShotTimer);
-                    return reinterpret_cast<uintptr_t>(singleShotTimer.get());
+                /// \param[in]  onExpiry    The callable object to call when the timer expires. Callables no bigger
+                ///                 than Timer::CALLBACK_CAPACITY bytes are stored inside the timer without allocating.
+                /// \param[in]  slack   How late the timer is allowed to expire. The timer will expire somewhere between
+                ///                 duration and duration + slack (plus up to one tick), at whatever time lets it
+                ///                 expire together with the most other timers.
+                /// \returns    A handle to the newly created timer.
+                /// \throws     std::invalid_argument if duration or slack is negative, OR onExpiry does not have an
+                ///             object to call (i.e. equates to false).
+                /// \throws     std::length_error if there are already MAX_NUM_TIMERS timers.
+                /// \note       Thread-safe, re-entrant and lock-free (except when the timer pool needs to grow).
+                template<typename F>
+                TimerHandle AddSingleShotTimer(std::chrono::microseconds duration, F&& onExpiry,
+                                               std::chrono::microseconds slack = std::chrono::microseconds(0)) {
+                    return AddTimer(TimerSpec::SingleShot(duration, std::forward<F>(onExpiry), slack));
                 }
 
                 /// \brief      Call to add a new repetitive timer to the timer wheel.
-                /// \returns    A unique timer ID for the newly created timer.
-                /// \note       Thread-safe and re-entrant.
-                uintptr_t AddRepetitiveTimer(std::chrono::milliseconds duration, int64_t numRepetitions, std::function<void()> onExpiry) {
-                    auto repetitiveTimer = std::make_shared<RepetitiveTimer>(duration, numRepetitions, onExpiry);
-                    AddTimer(repetitiveTimer);
-                    return reinterpret_cast<uintptr_t>(repetitiveTimer.get());
+                /// \details    Each deadline is scheduled one duration after the previous deadline (not after the time
+                ///             the timer was actually called), so the timer does not drift, however long the callbacks
+                ///             take.
+                /// \param[in]  numRepetitions  The number of times to call the timer, after which it is finished. Provide
+                ///                 -1 to repeat forever.
+                /// \param[in]  slack   How late each repetition of the timer is allowed to expire, see
+                ///                 AddSingleShotTimer().
+                /// \param[in]  missedTickPolicy    What to do if the timer expires so late that it's next deadlines have
+                ///                 already passed, see MissedTickPolicy. The number of deadlines that were missed can
+                ///                 be read with GetNumMissedTicks().
+                /// \returns    A handle to the newly created timer.
+                /// \throws     std::invalid_argument if duration or slack is negative, numRepetitions is not positive
+                ///             or -1, OR onExpiry does not have an object to call (i.e. equates to false).
+                /// \throws     std::length_error if there are already MAX_NUM_TIMERS timers.
+                /// \note       Thread-safe, re-entrant and lock-free (except when the timer pool needs to grow).
+                template<typename F>
+                TimerHandle AddRepetitiveTimer(std::chrono::microseconds duration, int64_t numRepetitions, F&& onExpiry,
+                                               std::chrono::microseconds slack = std::chrono::microseconds(0),
+                                               MissedTickPolicy missedTickPolicy = MissedTickPolicy::Skip) {
+                    return AddTimer(TimerSpec::Repetitive(duration, numRepetitions, std::forward<F>(onExpiry), slack,
+                                                          missedTickPolicy));
                 }
 
                 /// \brief      Call to remove a timer from the timer wheel.
-                /// \returns    True is timer was found (and removed), otherwise false.
-                bool RemoveTimer(uintptr_t timerId) {
+                /// \returns    True is timer was found (and removed), otherwise false. False is returned if the
+                ///             timer has already expired or been removed.
+                /// \note       Thread-safe, re-entrant and lock-free. The handle points directly at the timer, which
+                ///             is marked as cancelled with one compare-and-swap and then pushed onto the cancel inbox,
+                ///             to be unlinked from the wheel by the timer wheel thread.
+                bool RemoveTimer(TimerHandle timerHandle) {
+                    auto timer = CancelTimer(timerHandle);
+                    if(!timer)
+                        return false;
+
+                    // There is no need to wakeup the timer wheel thread, at worst it will wake up
+                    // at the time the removed timer would of expired and find nothing to do.
+                    PushInbox(cancelInbox_, timer, timer, &Timer::cancelNext_);
+                    return true;
+                }
 
-                    auto timerPtr = reinterpret_cast<Timer*>(timerId);
+                /// \brief      Call to restart a running timer, so that it expires newDuration from now (plus it's
+                ///             slack) rather than when it was going to. The timer is moved to it's new slot in place, it
+                ///             is not freed and added again, so the handle stays valid and nothing is allocated. Useful
+                ///             for watchdog and keepalive timers that are pushed back on every event.
+                /// \details    The new duration is stored in the timer, which is pushed onto the restart inbox (only if
+                ///             it is not already on it, so restarting a timer many times between two wakeups of the
+                ///             timer wheel thread only moves it once). The timer wheel thread is only woken up if the
+                ///             timer now expires before it was going to wake up anyway, so pushing a timer back costs
+                ///             a few atomic operations and no wakeups. If the timer is restarted just as it reaches it's
+                ///             old expiry, it does not expire.
+                ///             For a repetitive timer, newDuration also becomes the timer's period.
+                /// \returns    True if the timer was found (and restarted), otherwise false. False is returned if the
+                ///             timer has already expired or been removed.
+                /// \throws     std::invalid_argument if newDuration is negative.
+                /// \note       Thread-safe and re-entrant. Lock-free, except that if the same timer is restarted from
+                ///             multiple threads at once, the restarts are applied one after the other: a restart which
+                ///             finds another one part way through storing it's duration yields until that is done (a
+                ///             few instructions, unless the other thread is preempted). Every restart is applied, and the
+                ///             time is read once it is this restart's turn, so the restart applied last (which wins) is
+                ///             also the one made latest, e.g. concurrent keep-alives of a watchdog timer never bring it
+                ///             forward.
+                bool RestartTimer(TimerHandle timerHandle, std::chrono::microseconds newDuration) {
+                    if(newDuration.count() < 0)
+                        throw std::invalid_argument(std::string() + "The value of newDuration \"" +
+                                                    std::to_string(newDuration.count()) + "us\" provided to "
+                                                    + __PRETTY_FUNCTION__ + " was negative.");
 
-                    //==============================================//
-                    //============ START OF SYNC BLOCK =============//
-                    //==============================================//
-                    std::unique_lock<std::mutex> lock(mutex_);
+                    auto timer = GetTimer(timerHandle);
+                    if(!timer)
+                        return false;
+
+                    // Take the timer's restart writing flag, but only if the handle's generation is still current and
+                    // the timer is still running. If another thread holds the flag, it is restarting the same timer
+                    // right now, so yield until it has stored it's duration, and then store this one over it
+                    auto control = timer->control_.load(std::memory_order_relaxed);
+                    while(true) {
+                        if(GetGeneration(control) != timerHandle.generation_ || GetState(control) != TimerState::Running)
+                            return false;
+                        if(control & RESTART_WRITING) {
+                            std::this_thread::yield();
+                            control = timer->control_.load(std::memory_order_relaxed);
+                        } else if(timer->control_.compare_exchange_weak(control, control | RESTART_WRITING,
+                                                                        std::memory_order_acquire,
+                                                                        std::memory_order_relaxed)) {
+                            break;
+                        }
+                    }
 
-                    bool removedTimer = false;
-                    for(auto it = timers_.begin(); it != timers_.end(); ) {
-                        auto timer = *it;
-                        if(timer.get() == timerPtr) {
-                            // Found timer!
-                            it = timers_.erase(it);
-                            removedTimer = true;
-                        } else
-                            it++;
+                    // Read once holding the flag, so restarts are applied in the order of their times
+                    auto currTime = Now();
+
+                    timer->restartTime_.store(currTime.time_since_epoch().count(), std::memory_order_relaxed);
+                    timer->restartDuration_.store(newDuration.count(), std::memory_order_relaxed);
+
+                    // Swap the writing flag for the pending flag in one go (the timer may of been removed in the
+                    // meantime, in which case the timer wheel thread just drops the restart). This acquires as well,
+                    // so if the timer wheel thread has just cleared the pending flag, it's read of the restart link
+                    // happens before this thread writes it when pushing the timer again
+                    control = timer->control_.load(std::memory_order_relaxed);
+                    while(!timer->control_.compare_exchange_weak(control, (control & ~RESTART_WRITING) | RESTART_PENDING,
+                                                                 std::memory_order_acq_rel, std::memory_order_relaxed));
+
+                    // Whoever sets the pending flag pushes the timer, the timer wheel thread clears the flag when it
+                    // drains it
+                    if(!(control & RESTART_PENDING))
+                        PushInbox(restartInbox_, timer, timer, &Timer::restartNext_);
+
+                    WakeupIfEarlier(TimePointToTick(currTime + newDuration));
+                    return true;
+                }
+
+                /// \brief      Call to add a batch of timers to the timer wheel. All the timers are pushed onto the
+                ///             inbox at once, and the timer wheel thread is woken up at most once, which is much
+                ///             faster than calling AddSingleShotTimer() or AddRepetitiveTimer() for each timer.
+                /// \param[in]  first, last     The range of TimerSpecs to add. The range is iterated over twice, so
+                ///                 must be at least a forward range. The callbacks are moved out of the TimerSpecs.
+                /// \param[out] timerHandles    The handles to the new timers are written here, in the same order as
+                ///                 the TimerSpecs.
+                /// \returns    The output iterator, one past the last handle written.
+                /// \throws     std::invalid_argument if any of the TimerSpecs are invalid (see AddSingleShotTimer()).
+                ///             All the TimerSpecs are checked before any timers are added, so on error no timers are
+                ///             added.
+                /// \throws     std::length_error if there would be more than MAX_NUM_TIMERS timers. No timers are
+                ///             added.
+                /// \note       Thread-safe, re-entrant and lock-free (except when the timer pool needs to grow).
+                template<typename ForwardIt, typename OutputIt>
+                OutputIt AddTimers(ForwardIt first, ForwardIt last, OutputIt timerHandles) {
+                    for(auto it = first; it != last; ++it)
+                        CheckTimerArgs(*it);
+
+                    // All timers in the batch are started at the same time, so the clock only needs reading once
+                    auto currTime = Now();
+                    Timer* head = nullptr;
+                    Timer* tail = nullptr;
+                    uint64_t earliestExpiryTick = UINT64_MAX;
+                    try {
+                        for(; first != last; ++first) {
+                            TimerHandle timerHandle;
+                            auto timer = CreateTimer(*first, currTime, timerHandle);
+                            earliestExpiryTick = std::min(earliestExpiryTick, timer->expiryTick_);
+
+                            timer->addNext_ = head;
+                            head = timer;
+                            if(!tail)
+                                tail = timer;
+
+                            *timerHandles++ = timerHandle;
+                        }
+                    } catch(...) {
+                        // The pool is full, none of the batch has been pushed yet, so give the timers back
+                        while(head) {
+                            auto timer = head;
+                            head = timer->addNext_;
+                            auto generation = GetGeneration(timer->control_.load(std::memory_order_relaxed));
+                            timer->control_.store(MakeControl(NextGeneration(generation), TimerState::Cancelled),
+                                                  std::memory_order_relaxed);
+                            ReleaseTimer(timer);
+                        }
+                        throw;
                     }
 
-                    if(removedTimer)
-                        wakeup_ = true;
-                    lock.unlock();
-                    //==============================================//
-                    //============= END OF SYNC BLOCK ==============//
-                    //==============================================//
+                    if(head) {
+                        PushInbox(addInbox_, head, tail, &Timer::addNext_);
+                        WakeupIfEarlier(earliestExpiryTick);
+                    }
+                    return timerHandles;
+                }
 
-                    if(removedTimer)
-                        cv_.notify_one();
+                /// \brief      Call to remove a batch of timers from the timer wheel. The cancelled timers are pushed
+                ///             onto the cancel inbox at once.
+                /// \param[in]  first, last     The range of TimerHandles to remove.
+                /// \returns    The number of timers that were found (and removed). Handles to timers which have
+                ///             already expired or been removed are skipped.
+                /// \note       Thread-safe, re-entrant and lock-free.
+                template<typename InputIt>
+                std::size_t RemoveTimers(InputIt first, InputIt last) {
+                    std::size_t numRemoved = 0;
+                    Timer* head = nullptr;
+                    Timer* tail = nullptr;
+                    for(; first != last; ++first) {
+                        auto timer = CancelTimer(*first);
+                        if(!timer)
+                            continue;
+
+                        timer->cancelNext_ = head;
+                        head = timer;
+                        if(!tail)
+                            tail = timer;
+                        numRemoved++;
+                    }
 
-                    return removedTimer;
+                    if(head)
+                        PushInbox(cancelInbox_, head, tail, &Timer::cancelNext_);
+                    return numRemoved;
+                }
+
+                /// \returns    The number of wakeups of the timer wheel thread that have been saved by coalescing
+                ///             timers with slack. Each time timers with different deadlines expire together on the
+                ///             same tick, all but one of the deadlines would of needed a wakeup of their own.
+                /// \note       Thread-safe and re-entrant.
+                uint64_t GetNumWakeupsSaved() const {
+                    return numWakeupsSaved_.load(std::memory_order_relaxed);
+                }
+
+                /// \returns    The number of deadlines of a repetitive timer which were missed (and not called) because
+                ///             the timer expired too late, see MissedTickPolicy. Always 0 for timers with the Burst
+                ///             policy, as they call every missed deadline. Returns 0 if the handle is not valid (i.e.
+                ///             the timer has finished or been removed).
+                /// \note       Thread-safe and re-entrant.
+                uint64_t GetNumMissedTicks(TimerHandle timerHandle) const {
+                    auto timer = GetTimer(timerHandle);
+                    if(!timer)
+                        return 0;
+
+                    // Check the handle after reading the count, so a count from a newer timer re-using the node is not
+                    // returned
+                    auto numMissedTicks = timer->numMissedTicks_.load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    auto control = timer->control_.load(std::memory_order_relaxed);
+                    if(GetGeneration(control) != timerHandle.generation_ || GetState(control) != TimerState::Running)
+                        return 0;
+                    return numMissedTicks;
+                }
+
+                /// \brief      Moves a TimerWheel with a manual clock forward to timePoint, calling the callbacks of all
+                ///             the timers which are due on the calling thread (or handing them to the executor, if one
+                ///             was provided).
+                /// \details    The wheel is moved forward one occupied tick at a time (empty ticks are skipped, so
+                ///             large jumps are cheap), and the clock is set to the time of each tick while it's timers
+                ///             are processed, so callbacks (and any timers they add or restart) see the time the timer
+                ///             would of fired at in real time. Timers which expire on the same tick are called in order
+                ///             of their deadline, and then in the order they were added, so without an executor a
+                ///             simulation replays identically every time. Timers added by callbacks which are due before
+                ///             timePoint are also called before this returns. Once done, the clock is set to timePoint.
+                /// \throws     std::logic_error if the TimerWheel does not have a ManualClock.
+                /// \throws     std::invalid_argument if timePoint is before the clock's current time.
+                /// \warning    Not re-entrant, do not call from a timer callback. Only call from one thread at a time.
+                void AdvanceTo(Clock::time_point timePoint) {
+                    if(!manualClock_)
+                        throw std::logic_error(std::string() + __PRETTY_FUNCTION__ + " was called on a TimerWheel which "
+                                               "does not have a ManualClock.");
+
+                    auto& clock = *manualClock_;
+                    if(timePoint < clock.Now())
+                        throw std::invalid_argument(std::string() + "The timePoint provided to " + __PRETTY_FUNCTION__ +
+                                                    " was before the clock's current time.");
+
+                    auto targetTick = TimePointToTick(timePoint);
+                    while(true) {
+                        DrainInboxes();
+                        if(numTimers_ == 0)
+                            break;
+
+                        auto nextTick = FindNextTick();
+                        if(nextTick > targetTick)
+                            break;
+
+                        currentTick_ = nextTick;
+                        clock.SetTime(startTime_ + tickDuration_ * currentTick_);
+                        CascadeTimers();
+                        ExpireTimers();
+                        PublishNumTimers();
+
+                        if(!expiredTimers_.empty()) {
+                            std::sort(expiredTimers_.begin(), expiredTimers_.end(),
+                                      [](const ExpiredTimer& lhs, const ExpiredTimer& rhs) {
+                                return lhs.deadline < rhs.deadline ||
+                                       (lhs.deadline == rhs.deadline && lhs.timer->seq_ < rhs.timer->seq_);
+                            });
+                            RunExpiredTimers();
+                            expiredTimers_.clear();
+                        }
+                    }
+
+                    // Nothing was due on any of the ticks that were skipped
+                    currentTick_ = std::max(currentTick_, targetTick);
+                    PublishNumTimers();
+                    clock.SetTime(timePoint);
+                }
+
+                /// \returns    A snapshot of the TimerWheel's statistics: histograms of timer lateness and callback
+                ///             duration, the number of timers in the wheel, the number of wakeups and the time spent
+                ///             waiting for locks.
+                /// \details    The statistics are recorded with relaxed atomic operations as the timer wheel runs, which
+                ///             adds two clock reads per callback and nothing to adding or removing timers. The
+                ///             number of timers in the wheel is published by the timer wheel thread every time it wakes
+                ///             up.
+                /// \note       Thread-safe and re-entrant.
+                TimerWheelStats GetStats() const {
+                    TimerWheelStats stats;
+                    stats.lateness_ = lateness_.GetSnapshot();
+                    stats.callbackDuration_ = callbackDuration_.GetSnapshot();
+                    stats.numTimers_ = statsNumTimers_.load(std::memory_order_relaxed);
+                    for(uint32_t level = 0; level < numLevels_; level++)
+                        stats.numTimersInLevel_.push_back(statsNumTimersInLevel_[level].load(std::memory_order_relaxed));
+                    stats.numWakeups_ = numWakeups_.load(std::memory_order_relaxed);
+                    stats.numWakeupsSaved_ = numWakeupsSaved_.load(std::memory_order_relaxed);
+                    stats.numMissedTicks_ = numMissedTicks_.load(std::memory_order_relaxed);
+                    stats.lockWaitTime_ = std::chrono::nanoseconds(lockWaitTime_.load(std::memory_order_relaxed));
+                    stats.startTime_ = startTime_;
+                    stats.time_ = Now();
+                    return stats;
                 }
 
 
             private:
 
+                static constexpr uint32_t NO_TIMER = UINT32_MAX;
+
+                /// \brief      A timer which has expired, along with the deadline it expired for.
+                struct ExpiredTimer {
+                    Timer* timer;
+                    Clock::time_point deadline;
+                };
+
+                /// \brief      Flags kept in a timer's control word alongside the TimerState. RESTART_WRITING is set
+                ///             while a thread in RestartTimer() is storing the new duration, and RESTART_PENDING while
+                ///             the timer is on the restart inbox. While either is set, the timer can't expire or be
+                ///             returned to the pool.
+                static constexpr uint64_t RESTART_WRITING = uint64_t(1) << 30;
+                static constexpr uint64_t RESTART_PENDING = uint64_t(1) << 31;
+                static constexpr uint64_t RESTART_FLAGS = RESTART_WRITING | RESTART_PENDING;
+
+                static uint64_t MakeControl(uint32_t generation, TimerState state) {
+                    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(state);
+                }
+
+                static uint32_t GetGeneration(uint64_t control) {
+                    return static_cast<uint32_t>(control >> 32);
+                }
+
+                static TimerState GetState(uint64_t control) {
+                    return static_cast<TimerState>(static_cast<uint32_t>(control & (RESTART_WRITING - 1)));
+                }
+
+                /// \returns    The generation after the given one, skipping generation 0 on wrap-around (it is
+                ///             reserved for invalid handles).
+                static uint32_t NextGeneration(uint32_t generation) {
+                    generation++;
+                    return generation == 0 ? 1 : generation;
+                }
+
                 /// \brief      Use to add a new timer to the timer wheel.
-                /// \param[in]  numRepetitions   The number of repetitions this timer should execute. Set to -1 if you want
-                ///                 the timer to repeat indefinitely.
-                /// \returns    A pointer to the newly created timer.
+                /// \returns    A handle to the timer.
                 /// \note       Thread-safe and re-entrant.
-                void
-                AddTimer(std::shared_ptr<Timer> timer) {
-//                    std::cout << std::string() + __PRETTY_FUNCTION__ + " called.\n";
+                TimerHandle AddTimer(TimerSpec&& timerSpec) {
+                    CheckTimerArgs(timerSpec);
 
-                    //==============================================//
-                    //============ START OF SYNC BLOCK =============//
-                    //==============================================//
-                    std::unique_lock<std::mutex> lock(mutex_);
-                    InsertTimer(timer);
-                    wakeup_ = true;
-                    lock.unlock();
-                    //==============================================//
-                    //============= END OF SYNC BLOCK ==============//
-                    //==============================================//
+                    TimerHandle timerHandle;
+                    auto timer = CreateTimer(timerSpec, Now(), timerHandle);
 
-                    cv_.notify_one();
+                    // Once pushed, the timer belongs to the timer wheel thread (and may even of expired already), so
+                    // grab the expiry tick first
+                    auto expiryTick = timer->expiryTick_;
+                    PushInbox(addInbox_, timer, timer, &Timer::addNext_);
+                    WakeupIfEarlier(expiryTick);
+
+                    return timerHandle;
+                }
+
+                /// \throws     std::invalid_argument if duration or slack is negative, numRepetitions of a repetitive
+                ///             timer is not positive or -1, OR onExpiry does not have an object to call (i.e. equates
+                ///             to false).
+                static void CheckTimerArgs(const TimerSpec& timerSpec) {
+                    if(timerSpec.duration_.count() < 0)
+                        throw std::invalid_argument(std::string() + "The value of duration \"" +
+                                                    std::to_string(timerSpec.duration_.count()) + "us\" provided to "
+                                                    + __PRETTY_FUNCTION__ + " was negative.");
+
+                    if(timerSpec.slack_.count() < 0)
+                        throw std::invalid_argument(std::string() + "The value of slack \"" +
+                                                    std::to_string(timerSpec.slack_.count()) + "us\" provided to "
+                                                    + __PRETTY_FUNCTION__ + " was negative.");
+
+                    if(timerSpec.type_ == TimerType::Repetitive &&
+                       timerSpec.numRepetitions_ != -1 && timerSpec.numRepetitions_ <= 0)
+                        throw std::invalid_argument(std::string() + "The value of numRepetitions \"" +
+                                                    std::to_string(timerSpec.numRepetitions_) + "\" provided to "
+                                                    + __PRETTY_FUNCTION__ + " was not positive or -1.");
+
+                    if(!timerSpec.onExpiry_)
+                        throw std::invalid_argument(std::string() + "onExpiry provided to " + __PRETTY_FUNCTION__ +
+                                                    " does not have a valid object to call.");
+                }
+
+                /// \brief      Takes a timer from the pool and sets it up to start at currTime. The timer still has to
+                ///             be pushed onto the add inbox.
+                /// \param[in]  timerSpec   The callback is moved out of this.
+                /// \param[out] timerHandle     Set to the handle to the new timer.
+                Timer* CreateTimer(TimerSpec& timerSpec, Clock::time_point currTime, TimerHandle& timerHandle) {
+                    auto timer = AllocateTimer();
+                    timer->type_ = timerSpec.type_;
+                    timer->duration_ = timerSpec.duration_;
+                    timer->slack_ = timerSpec.slack_;
+                    timer->numRepetitions_ = timerSpec.numRepetitions_;
+                    timer->missedTickPolicy_ = timerSpec.missedTickPolicy_;
+                    timer->onExpiry_ = std::move(timerSpec.onExpiry_);
+                    timer->numMissedTicks_.store(0, std::memory_order_relaxed);
+                    timer->cancelDrained_ = false;
+                    if(manualClock_)
+                        timer->seq_ = nextSeq_.fetch_add(1, std::memory_order_relaxed);
+                    CalculateExpiry(timer, currTime);
+
+                    timer->refCount_.store(1, std::memory_order_relaxed);
+                    auto generation = GetGeneration(timer->control_.load(std::memory_order_relaxed));
+                    timer->control_.store(MakeControl(generation, TimerState::Running), std::memory_order_release);
+
+                    timerHandle = TimerHandle(timer->index_, generation);
+                    return timer;
+                }
+
+                /// \brief      Marks the timer the handle refers to as cancelled.
+                /// \returns    The timer, or nullptr if the handle is not valid (i.e. the timer has expired or been
+                ///             removed). If a timer is returned, the caller must push it onto the cancel inbox.
+                Timer* CancelTimer(TimerHandle timerHandle) {
+                    auto timer = GetTimer(timerHandle);
+                    if(!timer)
+                        return nullptr;
+
+                    // Only succeeds if the handle's generation is still current and the timer is still running. The
+                    // generation is incremented at the same time, so the handle is no longer valid. The restart flags
+                    // are kept, so the timer wheel thread knows the timer is still (or is about to be) on the restart
+                    // inbox
+                    auto control = timer->control_.load(std::memory_order_relaxed);
+                    do {
+                        if(GetGeneration(control) != timerHandle.generation_ || GetState(control) != TimerState::Running)
+                            return nullptr;
+                    } while(!timer->control_.compare_exchange_weak(
+                            control, MakeControl(NextGeneration(timerHandle.generation_), TimerState::Cancelled) |
+                                     (control & RESTART_FLAGS)));
+                    return timer;
+                }
+
+                /// \brief      Wakes up the timer wheel thread, but only if a new timer expires before the thread was
+                ///             going to wake up anyway.
+                /// \note       Call after pushing the new timers onto the add inbox. Either the timer wheel thread has
+                ///             not published it's next wakeup yet (in which case it will check the inbox again before
+                ///             going to sleep), or this sees the wakeup it has published.
+                void WakeupIfEarlier(uint64_t expiryTick) {
+                    if(expiryTick < scheduledTick_.load())
+                        waiter_.Notify();
+                }
+
+                /// \brief      Pushes a list of timers (already linked together through the next member, from first to
+                ///             last) onto an inbox.
+                static void PushInbox(std::atomic<Timer*>& inbox, Timer* first, Timer* last, Timer* Timer::*next) {
+                    auto head = inbox.load(std::memory_order_relaxed);
+                    do {
+                        last->*next = head;
+                    } while(!inbox.compare_exchange_weak(head, first));
+                }
+
+                /// \brief      Locks the mutex, adding the time spent waiting for it (if it was already locked) to the
+                ///             lock wait time statistic.
+                std::unique_lock<std::mutex> Lock(std::mutex& mutex) {
+                    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+                    if(!lock.owns_lock()) {
+                        auto startTime = Clock::now();
+                        lock.lock();
+                        lockWaitTime_.fetch_add(
+                                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count(),
+                                std::memory_order_relaxed);
+                    }
+                    return lock;
+                }
+
+                //==============================================//
+                //=================== POOL =====================//
+                //==============================================//
+
+                /// \returns    The timer at the index in the pool. The index must be of a timer in a chunk that has
+                ///             already been allocated.
+                Timer* GetPoolTimer(uint32_t index) const {
+                    return &poolChunks_[index >> POOL_CHUNK_BITS].load(std::memory_order_acquire)[index & (POOL_CHUNK_SIZE - 1)];
+                }
+
+                /// \brief      Takes a timer from the pool's free list, growing the pool by one chunk if there are no
+                ///             free timers left.
+                /// \throws     std::length_error if there are already MAX_NUM_TIMERS timers.
+                /// \note       Lock-free, unless the pool has to grow.
+                Timer* AllocateTimer() {
+                    while(true) {
+                        // The free list head holds the index of the first free timer in the lower 32 bits, and a count
+                        // in the upper 32 bits which is incremented on every change, so that a pop can't succeed if
+                        // the head has been popped and pushed back by other threads in the meantime (the ABA problem)
+                        auto head = freeHead_.load(std::memory_order_acquire);
+                        while(static_cast<uint32_t>(head) != NO_TIMER) {
+                            auto timer = GetPoolTimer(static_cast<uint32_t>(head));
+                            auto next = timer->nextFree_.load(std::memory_order_relaxed);
+                            auto newHead = (((head >> 32) + 1) << 32) | next;
+                            if(freeHead_.compare_exchange_weak(head, newHead, std::memory_order_acquire,
+                                                               std::memory_order_acquire))
+                                return timer;
+                        }
+                        GrowPool();
+                    }
+                }
+
+                /// \brief      Adds a new chunk of timers to the pool, unless another thread has already done so.
+                /// \throws     std::length_error if there are already MAX_NUM_TIMERS timers.
+                void GrowPool() {
+                    auto lock = Lock(poolMutex_);
+                    if(static_cast<uint32_t>(freeHead_.load()) != NO_TIMER)
+                        return;
+
+                    auto chunkIndex = static_cast<uint32_t>(pool_.size());
+                    if(chunkIndex == MAX_NUM_POOL_CHUNKS)
+                        throw std::length_error(std::string() + __PRETTY_FUNCTION__ + " could not add timer, there are "
+                                                "already " + std::to_string(MAX_NUM_TIMERS) + " timers.");
+
+                    pool_.push_back(std::unique_ptr<Timer[]>(new Timer[POOL_CHUNK_SIZE]));
+                    auto& chunk = pool_.back();
+                    for(uint32_t i = 0; i < POOL_CHUNK_SIZE; i++) {
+                        chunk[i].index_ = (chunkIndex << POOL_CHUNK_BITS) | i;
+                        if(i + 1 < POOL_CHUNK_SIZE)
+                            chunk[i].nextFree_.store(chunk[i].index_ + 1, std::memory_order_relaxed);
+                    }
+                    poolChunks_[chunkIndex].store(chunk.get(), std::memory_order_release);
+                    PushFreeTimers(&chunk[0], &chunk[POOL_CHUNK_SIZE - 1]);
+                }
+
+                /// \brief      Pushes a list of timers (already linked together through nextFree_, from first to last)
+                ///             onto the pool's free list.
+                void PushFreeTimers(Timer* first, Timer* last) {
+                    auto head = freeHead_.load(std::memory_order_relaxed);
+                    uint64_t newHead;
+                    do {
+                        last->nextFree_.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+                        newHead = (((head >> 32) + 1) << 32) | first->index_;
+                    } while(!freeHead_.compare_exchange_weak(head, newHead, std::memory_order_release,
+                                                             std::memory_order_relaxed));
                 }
 
+                /// \brief      Destroys the timer's callback and puts the timer back onto the pool's free list. It keeps
+                ///             it's generation, which has already been incremented when it finished or was removed.
+                void FreeTimer(Timer* timer) {
+                    timer->onExpiry_.Reset();
+                    auto generation = GetGeneration(timer->control_.load(std::memory_order_relaxed));
+                    timer->control_.store(MakeControl(generation, TimerState::Initialized), std::memory_order_relaxed);
+                    PushFreeTimers(timer, timer);
+                }
+
+                /// \brief      Drops one of the timer's references, returning it to the pool if it was the last one.
+                void ReleaseTimer(Timer* timer) {
+                    if(timer->refCount_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        FreeTimer(timer);
+                }
+
+                /// \returns    The timer the handle points at, or nullptr if the handle can't point at a timer at all.
+                ///             The caller still has to check the handle's generation.
+                Timer* GetTimer(TimerHandle timerHandle) const {
+                    auto chunkIndex = timerHandle.index_ >> POOL_CHUNK_BITS;
+                    if(chunkIndex >= MAX_NUM_POOL_CHUNKS)
+                        return nullptr;
+                    auto chunk = poolChunks_[chunkIndex].load(std::memory_order_acquire);
+                    if(!chunk)
+                        return nullptr;
+                    return &chunk[timerHandle.index_ & (POOL_CHUNK_SIZE - 1)];
+                }
+
+                //==============================================//
+                //============ TIMER WHEEL THREAD ==============//
+                //==============================================//
+
                 /// \brief      Function for the timer wheel thread.
                 void Process() {
-                    std::cout << "Process called." << std::endl;
-                    std::unique_lock<std::mutex> lock(mutex_);
-                    std::chrono::milliseconds queueWaitTime;
+                    Waiter::MinimiseTimerSlack();
 
                     while (true) {
 
                         // Check for exit condition
-                        if (exit_)
+                        if (exit_.load())
                             return;
 
-                        wakeup_ = false;
+                        DrainInboxes();
 
-                        CheckTimers(queueWaitTime);
+                        uint64_t nextTick;
+                        bool timersRunning = CheckTimers(nextTick);
+                        PublishNumTimers();
 
-                        if (timers_.size() == 0) {
-//                            std::cout << "No timers present, waiting for notify..." << std::endl;
-                            while (!wakeup_)
-                                cv_.wait(lock);
-//                            std::cout << "Notify received on TimerWheel thread." << std::endl;
+                        if (!expiredTimers_.empty()) {
+                            // Call the expired timer callbacks, and then check the timers again, as time has passed
+                            // and other threads may of added or removed timers
+                            RunExpiredTimers();
+                            expiredTimers_.clear();
+                            continue;
+                        }
 
-                        } else {
-                            // Calculate time to wait based on next timer to expire
-//                            std::cout << "Timers present, calling wait_for() with queueWaitTime (ms) = "
-//                                      << std::to_string(queueWaitTime.count()) << std::endl;
-//                            cmdReceived = threadSafeQueue_.TryPop(timerWheelCmd, queueWaitTime);
-//                            isNotify = semaphore_.TryWait(queueWaitTime);
-
-                            cv_.wait_for(lock, queueWaitTime, [&] {
-                                return wakeup_;
+                        // Publish when this thread is going to wake up, and then check the inboxes one last time. A
+                        // thread adding a timer either pushed it before this check (so it is drained straight away),
+                        // or sees the new scheduledTick_ and notifies the waiter if it's timer expires earlier
+                        scheduledTick_.store(timersRunning ? nextTick : UINT64_MAX);
+                        if (addInbox_.load() || cancelInbox_.load() || restartInbox_.load())
+                            continue;
+
+                        if (timersRunning)
+                            waiter_.WaitUntil(ToSteadyTime(startTime_ + tickDuration_ * nextTick));
+                        else
+                            waiter_.Wait();
+                        numWakeups_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                /// \brief      Copies the number of timers in the wheel to where GetStats() can read them.
+                /// \warning       Only call from the timer wheel thread.
+                void PublishNumTimers() {
+                    statsNumTimers_.store(numTimers_, std::memory_order_relaxed);
+                    for(uint32_t level = 0; level < numLevels_; level++)
+                        statsNumTimersInLevel_[level].store(numTimersInLevel_[level], std::memory_order_relaxed);
+                }
+
+                /// \brief      Links all the timers that have been added into the wheel, moves all the timers that have
+                ///             been restarted, and unlinks all the timers that have been removed.
+                /// \warning       Only call from the timer wheel thread.
+                void DrainInboxes() {
+                    // The restart and cancel inboxes must be taken first. A timer can only be restarted or removed
+                    // after it has been added, so this guarantees that the add of every timer in those lists is drained
+                    // now or already has been
+                    auto restarted = restartInbox_.exchange(nullptr);
+                    auto cancelled = cancelInbox_.exchange(nullptr);
+                    auto added = addInbox_.exchange(nullptr);
+
+                    // If the wheel has been idle, fast-forward it to the current time so the
+                    // thread does not have to walk through every tick that passed while nothing was running
+                    if(added && numTimers_ == 0)
+                        currentTick_ = std::max(currentTick_, TimePointToTick(Now()));
+
+                    while(added) {
+                        auto timer = added;
+                        added = timer->addNext_;
+
+                        // The timer may of already been removed, in which case it is released below (or on the next
+                        // drain)
+                        if(GetState(timer->control_.load(std::memory_order_acquire)) != TimerState::Running)
+                            continue;
+
+                        // The expiry was calculated when the timer was added, but the earliest it can now expire is
+                        // the next tick
+                        timer->deadlineTick_ = std::max(timer->deadlineTick_, currentTick_ + 1);
+                        timer->expiryTick_ = std::max(timer->expiryTick_, currentTick_ + 1);
+                        LinkTimer(timer);
+                        timer->linked_ = true;
+                        numTimers_++;
+                    }
+
+                    while(restarted) {
+                        auto timer = restarted;
+                        // Read the link before clearing the flag, as the timer can be restarted (and pushed again)
+                        // straight after
+                        restarted = timer->restartNext_;
+                        DrainRestart(timer);
+                    }
+
+                    while(cancelled) {
+                        auto timer = cancelled;
+                        cancelled = timer->cancelNext_;
+
+                        if(timer->linked_) {
+                            UnlinkTimer(timer);
+                            timer->linked_ = false;
+                            numTimers_--;
+                        }
+
+                        // If the timer is still on the restart inbox, it is released when the restart is drained
+                        timer->cancelDrained_ = true;
+                        if(!(timer->control_.load(std::memory_order_acquire) & RESTART_FLAGS))
+                            ReleaseTimer(timer);
+                    }
+                }
+
+                /// \brief      Moves a timer that has been taken off the restart inbox to it's new slot.
+                /// \warning       Only call from the timer wheel thread.
+                void DrainRestart(Timer* timer) {
+                    auto control = timer->control_.fetch_and(~RESTART_PENDING, std::memory_order_acq_rel);
+
+                    // If another restart is being written, that thread will push the timer again (as the pending flag
+                    // is now clear), so leave it until then
+                    if(control & RESTART_WRITING)
+                        return;
+
+                    if(GetState(control) != TimerState::Running) {
+                        // Removed while the restart was pending. If the cancel has already been drained, it left
+                        // releasing the wheel's reference to this
+                        if(timer->cancelDrained_)
+                            ReleaseTimer(timer);
+                        return;
+                    }
+
+                    auto restartTime = Clock::time_point(Clock::duration(timer->restartTime_.load(std::memory_order_relaxed)));
+                    auto restartDuration = std::chrono::microseconds(timer->restartDuration_.load(std::memory_order_relaxed));
+
+                    // If another restart started while the duration was being read, it may of been half written. That
+                    // restart will push the timer again, so leave it until then
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if(timer->control_.load(std::memory_order_relaxed) & RESTART_FLAGS)
+                        return;
+
+                    if(timer->linked_) {
+                        UnlinkTimer(timer);
+                        numTimers_--;
+                    }
+
+                    timer->duration_ = restartDuration;
+                    CalculateExpiry(timer, restartTime);
+                    timer->deadlineTick_ = std::max(timer->deadlineTick_, currentTick_ + 1);
+                    timer->expiryTick_ = std::max(timer->expiryTick_, currentTick_ + 1);
+                    LinkTimer(timer);
+                    timer->linked_ = true;
+                    numTimers_++;
+                }
+
+                /// \brief      Calls the onExpiry callbacks of all timers that CheckTimers() found to have expired,
+                ///             either directly or by handing them to the executor.
+                /// \warning       Only call from the timer wheel thread.
+                void RunExpiredTimers() {
+                    // Callback durations are always measured in real time, lateness is measured with the clock source
+                    auto currTime = Clock::now();
+                    if(executor_) {
+                        {
+                            auto lock = Lock(mutex_);
+                            numExecutorCallbacks_ += expiredTimers_.size();
+                        }
+
+                        for(auto& expiredTimer : expiredTimers_) {
+                            RecordLateness(expiredTimer, clockSource_ ? clockSource_->Now() : currTime);
+
+                            // The timer holds a reference for the callback, so it stays out of the pool (and the
+                            // callback stays valid) even if the timer is removed before the executor gets around to
+                            // running it. The task is only two pointers, so std::function stores it without allocating
+                            auto timer = expiredTimer.timer;
+                            executor_->Execute([this, timer]() {
+                                auto startTime = Clock::now();
+                                timer->onExpiry_();
+                                RecordCallbackDuration(Clock::now() - startTime);
+                                ReleaseTimer(timer);
+
+                                auto lock = Lock(mutex_);
+                                numExecutorCallbacks_--;
+                                if(numExecutorCallbacks_ == 0)
+                                    executorCallbacksDone_.notify_all();
                             });
-//                            std::cout << "Notify/wakeup received on TimerWheel thread." << std::endl;
+                        }
+                    } else {
+                        // Each callback starts when the last one finished, so the clock only needs reading once per
+                        // callback
+                        for(auto& expiredTimer : expiredTimers_) {
+                            RecordLateness(expiredTimer, clockSource_ ? clockSource_->Now() : currTime);
+                            expiredTimer.timer->onExpiry_();
+                            auto endTime = Clock::now();
+                            RecordCallbackDuration(endTime - currTime);
+                            currTime = endTime;
+                            ReleaseTimer(expiredTimer.timer);
                         }
                     }
                 }
 
-                /// \warning       Only call while mutex_ is locked.
-                void InsertTimer(const std::shared_ptr<Timer> &timerToInsert) {
-                    // Need to insert the new timer into the deque sorted on remaining time
-//                    std::cout << "Inserting timer...\n";
-                    bool timerInserted = false;
+                void RecordLateness(const ExpiredTimer& expiredTimer, Clock::time_point currTime) {
+                    auto lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(currTime - expiredTimer.deadline);
+                    lateness_.Record(static_cast<uint64_t>(std::max<int64_t>(lateness.count(), 0)));
+                }
+
+                void RecordCallbackDuration(Clock::duration duration) {
+                    callbackDuration_.Record(static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+                }
+
+                /// \returns    The current time, from the clock source if one was provided.
+                Clock::time_point Now() const {
+                    return clockSource_ ? clockSource_->Now() : Clock::now();
+                }
 
-                    auto currTime = std::chrono::system_clock::now();
+                /// \brief      Converts a time point of the clock source into std::chrono::steady_clock time, for the
+                ///             waiter to sleep until.
+                Clock::time_point ToSteadyTime(Clock::time_point timePoint) const {
+                    if(!clockSource_)
+                        return timePoint;
+                    return Clock::now() + (timePoint - clockSource_->Now());
+                }
+
+                /// \brief      Converts a time point into the wheel tick it falls within (i.e. rounded down).
+                uint64_t TimePointToTick(Clock::time_point timePoint) const {
+                    if(timePoint <= startTime_)
+                        return 0;
+                    return static_cast<uint64_t>((timePoint - startTime_) / tickDuration_);
+                }
+
+                /// \brief      Calculates the deadline and expiry ticks for a timer starting at currTime.
+                /// \note       Only reads the wheel's constant configuration, so can be called from any thread.
+                void CalculateExpiry(Timer* timer, Clock::time_point currTime) const {
 
                     // Set start time to current time point
-                    timerToInsert->SetStartTime(currTime);
+                    timer->SetStartTime(currTime);
+
+                    // Round the deadline up to the next tick, so that timers never expire early
+                    auto deadline = (currTime + timer->duration_) - startTime_;
+                    auto deadlineTick = static_cast<uint64_t>((deadline + tickDuration_ - Clock::duration(1)) / tickDuration_);
+                    timer->deadlineTick_ = deadlineTick;
+
+                    // Apply the slack. Of all the ticks the timer is allowed to expire on, pick the one with the most
+                    // trailing zero bits. Timers with nearby deadlines end up picking the same tick, and so
+                    // expire together on one wakeup
+                    auto latestTick = static_cast<uint64_t>((deadline + timer->slack_) / tickDuration_);
+                    auto expiryTick = deadlineTick;
+                    if(latestTick > deadlineTick) {
+                        // Find the highest bit that differs between the deadline and latest tick, and clear all the
+                        // bits below it in the latest tick
+                        uint64_t bit = 1ull << (63 - __builtin_clzll(latestTick ^ deadlineTick));
+                        expiryTick = latestTick & ~(bit - 1);
+                    }
 
-                    auto newTimerRemainingTime = timerToInsert->duration_ -
-                                                 std::chrono::duration_cast<std::chrono::milliseconds>(
-                                                         currTime - timerToInsert->startTime_);
+                    timer->expiryTick_ = expiryTick;
+                }
 
-                    for (auto it = timers_.begin(); it != timers_.end(); ++it) {
-                        auto timer = *it;
-                        auto remainingTime = timer->duration_ - std::chrono::duration_cast<std::chrono::milliseconds>(
-                                currTime - timer->startTime_);
+                /// \brief      Links the timer into the correct slot of the wheel, based on how far away it's expiry
+                ///             tick is from currentTick_.
+                /// \warning       Only call from the timer wheel thread.
+                void LinkTimer(Timer* timer) {
+                    uint64_t ticksRemaining = timer->expiryTick_ - currentTick_;
+
+                    // Find the lowest level which spans the ticks remaining
+                    uint32_t level = 0;
+                    while(level < numLevels_ - 1 && ticksRemaining >= (1ull << (SLOT_BITS * (level + 1))))
+                        level++;
+
+                    uint64_t slotTick = timer->expiryTick_;
+
+                    // If the timer is beyond the span of the top level, link it into the furthest slot away. It will
+                    // be cascaded back into the top level (or lower) when that slot comes around.
+                    uint64_t maxTicksRemaining = (1ull << (SLOT_BITS * (level + 1))) - 1;
+                    if(ticksRemaining > maxTicksRemaining)
+                        slotTick = currentTick_ + maxTicksRemaining;
+
+                    timer->level_ = level;
+                    timer->slot_ = static_cast<uint32_t>((slotTick >> (SLOT_BITS * level)) & (SLOTS_PER_LEVEL - 1));
+
+                    Timer*& head = slots_[level * SLOTS_PER_LEVEL + timer->slot_];
+                    timer->prev_ = nullptr;
+                    timer->next_ = head;
+                    if(head)
+                        head->prev_ = timer;
+                    head = timer;
+                    occupiedSlots_[level * OCCUPIED_WORDS_PER_LEVEL + timer->slot_ / 64] |= 1ull << (timer->slot_ % 64);
+
+                    numTimersInLevel_[level]++;
+                }
 
-                        if (newTimerRemainingTime > remainingTime)
-                            continue;
-                        else {
-                            // Current timer in queue has more remaining time, so insert new timer
-                            // before this one!
-                            timers_.insert(it, timerToInsert);
-                            timerInserted = true;
-                            break;
-                        }
+                /// \brief      Unlinks the timer from it's slot in the wheel.
+                /// \warning       Only call from the timer wheel thread.
+                void UnlinkTimer(Timer* timer) {
+                    if(timer->prev_)
+                        timer->prev_->next_ = timer->next_;
+                    else {
+                        slots_[timer->level_ * SLOTS_PER_LEVEL + timer->slot_] = timer->next_;
+                        if(!timer->next_)
+                            ClearSlotOccupied(timer->level_, timer->slot_);
                     }
 
-                    // If we finish the iterator loop and the timer hasn't already been inserted,
-                    // the timer needs to be inserted at the end
-                    if (!timerInserted)
-                        timers_.push_back(timerToInsert);
+                    if(timer->next_)
+                        timer->next_->prev_ = timer->prev_;
+
+                    timer->prev_ = nullptr;
+                    timer->next_ = nullptr;
+                    numTimersInLevel_[timer->level_]--;
                 }
 
-                /// \brief      Checks all active timers. If any have expired, their onExpiry callbacks are called and then
-                ///             the timer is removed.
-                /// \param[out] nextExpiry  The earliest expiry duration from now for any of the active timers.
-                /// \warning       Only call while mutex_ is locked.
-                void CheckTimers(std::chrono::milliseconds &nextExpiry) {
-//                    std::cout << "Checking timers. Num timers = " << timers_.size() << std::endl;
+                /// \brief      Removes all timers from a slot, returning them as a singly-linked list (through next_).
+                /// \warning       Only call from the timer wheel thread.
+                Timer* DetachSlot(uint32_t level, uint32_t slot) {
+                    Timer*& head = slots_[level * SLOTS_PER_LEVEL + slot];
+                    Timer* list = head;
+                    head = nullptr;
+                    ClearSlotOccupied(level, slot);
+                    for(auto timer = list; timer != nullptr; timer = timer->next_)
+                        numTimersInLevel_[level]--;
+                    return list;
+                }
 
-                    auto currTime = std::chrono::system_clock::now();
+                /// \brief      Advances the wheel up to the current time, expiring any timers that are due. Expired
+                ///             timers are added to expiredTimers_ (so their callbacks can be called afterwards), and
+                ///             then removed (or re-inserted, for repetitive timers).
+                /// \param[out] nextTick  The next tick the wheel thread needs to wake up on.
+                /// \returns    True if there are still timers running (and nextTick is valid), otherwise false.
+                /// \warning       Only call from the timer wheel thread.
+                bool CheckTimers(uint64_t &nextTick) {
+
+                    auto nowTick = TimePointToTick(Now());
+
+                    while(currentTick_ < nowTick && numTimers_ != 0) {
+                        // Nothing needs doing on the ticks before the next one found, so skip straight to it
+                        currentTick_ = std::min(FindNextTick(), nowTick);
+                        CascadeTimers();
+                        ExpireTimers();
+                    }
 
-                    // Timers are sorted by expiry time (earliest expiry time is first)
-                    int count = 0;
-                    for (auto it = timers_.begin(); it != timers_.end();) {
-//                        std::cout << "Checking timer " << (*it).get() << "at position " << count << std::endl;
-                        count++;
+                    if(numTimers_ == 0) {
+                        currentTick_ = std::max(currentTick_, nowTick);
+                        return false;
+                    }
 
-                        auto timer = *it;
+                    nextTick = FindNextTick();
+                    return true;
+                }
 
-//                        std::cout << "timer->startTime = " << timer->startTime_.time_since_epoch().count() << std::endl;
-//                        std::cout << "currTime = " << currTime.time_since_epoch().count() << std::endl;
-                        std::chrono::milliseconds durationSinceTimerStart = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                currTime - timer->startTime_);
-//                        std::cout << "durationSinceTimerStart (ms) = " << durationSinceTimerStart.count() << std::endl;
+                /// \brief      Clears a slot's bit in the occupancy bitmap, once the slot is empty.
+                /// \warning       Only call from the timer wheel thread.
+                void ClearSlotOccupied(uint32_t level, uint32_t slot) {
+                    occupiedSlots_[level * OCCUPIED_WORDS_PER_LEVEL + slot / 64] &= ~(1ull << (slot % 64));
+                }
 
-                        auto remainingTime = timer->duration_ - durationSinceTimerStart;
-//                        std::cout << "remainingTime (ms) = " << remainingTime.count() << std::endl;
+                /// \returns    How many slots after the given slot the next occupied slot of the level is, from 1 to
+                ///             SLOTS_PER_LEVEL (the given slot itself coming around last), or 0 if the level is empty.
+                ///             Found with at most OCCUPIED_WORDS_PER_LEVEL + 1 count trailing zeros, rather than
+                ///             checking every slot.
+                /// \warning       Only call from the timer wheel thread.
+                uint32_t GetNextOccupiedSlotDistance(uint32_t level, uint32_t slot) const {
+                    auto words = &occupiedSlots_[level * OCCUPIED_WORDS_PER_LEVEL];
+                    auto start = (slot + 1) & (SLOTS_PER_LEVEL - 1);
+                    auto wordIndex = start / 64;
+                    // Ignore the slots before the start in it's word, they are checked when the search wraps around
+                    auto word = words[wordIndex] & (~0ull << (start % 64));
+                    for(uint32_t i = 0; i <= OCCUPIED_WORDS_PER_LEVEL; i++) {
+                        if(word != 0) {
+                            auto occupiedSlot = wordIndex * 64 + static_cast<uint32_t>(__builtin_ctzll(word));
+                            return ((occupiedSlot - slot - 1) & (SLOTS_PER_LEVEL - 1)) + 1;
+                        }
+                        wordIndex = (wordIndex + 1) % OCCUPIED_WORDS_PER_LEVEL;
+                        word = words[wordIndex];
+                    }
+                    return 0;
+                }
 
-                        if (remainingTime.count() <= 0) {
-                            // Timer has expired!
-//                            std::cout << "Timer has expired." << std::endl;
-                            timer->onExpiry_();
-                            it = timers_.erase(it);
+                /// \brief      Finds the next tick the wheel needs processing on. This is either the next occupied slot
+                ///             in level 0, or the next cascade of a higher level slot which has timers in it, whatever
+                ///             comes first. Nothing needs doing on any of the ticks before it, so an idle wheel with
+                ///             only long timers does not wake up every time level 0 wraps. The occupied slots are
+                ///             found from the occupancy bitmaps, so this is O(1) in the number of slots.
+                /// \warning       Only call from the timer wheel thread, when there are timers in the wheel.
+                uint64_t FindNextTick() const {
+                    uint64_t nextTick = UINT64_MAX;
+                    for(uint32_t level = 0; level < numLevels_; level++) {
+                        // The slots of this level are processed one after the other, every 2^(SLOT_BITS * level)
+                        // ticks
+                        auto shift = SLOT_BITS * level;
+                        auto currentSlotTick = currentTick_ >> shift;
+                        auto distance = GetNextOccupiedSlotDistance(
+                                level, static_cast<uint32_t>(currentSlotTick & (SLOTS_PER_LEVEL - 1)));
+                        if(distance != 0)
+                            nextTick = std::min(nextTick, (currentSlotTick + distance) << shift);
+                    }
 
-                            if (auto repetitiveTimer = std::dynamic_pointer_cast<RepetitiveTimer>(timer)) {
-//                                std::cout << "Timer is REPEATITIVE, re-adding...\n";
-                                InsertTimer(timer);
-                            }
+                    // Should never get here, but if we do, just wake up at the next cascade
+                    if(nextTick == UINT64_MAX)
+                        return (currentTick_ | (SLOTS_PER_LEVEL - 1)) + 1;
+                    return nextTick;
+                }
 
-                            continue;
+                /// \brief      Cascades timers from the higher levels down to lower levels when the lower level
+                ///             wraps around.
+                /// \warning       Only call from the timer wheel thread.
+                void CascadeTimers() {
+                    for(uint32_t level = 1; level < numLevels_; level++) {
+                        // A level only needs cascading when all the levels below it have wrapped
+                        if((currentTick_ & ((1ull << (SLOT_BITS * level)) - 1)) != 0)
+                            break;
+
+                        auto slot = static_cast<uint32_t>((currentTick_ >> (SLOT_BITS * level)) & (SLOTS_PER_LEVEL - 1));
+                        auto timer = DetachSlot(level, slot);
+                        while(timer) {
+                            auto next = timer->next_;
+                            LinkTimer(timer);
+                            timer = next;
+                        }
+                    }
+                }
+
+                /// \brief      Expires all the timers in the level 0 slot for currentTick_.
+                /// \warning       Only call from the timer wheel thread.
+                void ExpireTimers() {
+                    auto timer = DetachSlot(0, static_cast<uint32_t>(currentTick_ & (SLOTS_PER_LEVEL - 1)));
+                    deadlineTicks_.clear();
+                    while(timer) {
+                        auto next = timer->next_;
+
+                        if(timer->expiryTick_ > currentTick_) {
+                            // Timer was beyond the span of the wheel and still has further to go
+                            LinkTimer(timer);
                         } else {
-//                            std::cout << "Timer has NOT expired." << std::endl;
-                            // Timer expiry is still in the future. Since the deque is sorted, this
-                            // is the earliest expiring timer, so return the remaining time
-                            nextExpiry = remainingTime;
+                            // Grab the deadline first, as a repetitive timer is re-inserted when it expires
+                            ExpiredTimer expiredTimer = { timer, timer->startTime_ + timer->duration_ };
+                            auto deadlineTick = timer->deadlineTick_;
+                            if(ExpireTimer(timer)) {
+                                // Timer has expired!
+                                expiredTimers_.push_back(expiredTimer);
+                                deadlineTicks_.push_back(deadlineTick);
+                            }
+                        }
 
-                            // There is still a timer we need to wait for, so return true
-                            return;
+                        timer = next;
+                    }
+
+                    // Without slack, each distinct deadline would of needed it's own wakeup
+                    if(!deadlineTicks_.empty()) {
+                        std::sort(deadlineTicks_.begin(), deadlineTicks_.end());
+                        auto numDeadlines = std::unique(deadlineTicks_.begin(), deadlineTicks_.end()) - deadlineTicks_.begin();
+                        numWakeupsSaved_.fetch_add(static_cast<uint64_t>(numDeadlines - 1), std::memory_order_relaxed);
+                    }
+                }
+
+                /// \brief      Expires a timer that has been detached from it's slot, re-inserting it if it is a
+                ///             repetitive timer.
+                /// \returns    True if the timer's callback needs calling, in which case the timer holds a reference
+                ///             for the callback. False if the timer has been removed in the meantime (it is then
+                ///             released when the timer wheel thread drains it from the cancel inbox).
+                /// \warning       Only call from the timer wheel thread.
+                bool ExpireTimer(Timer* timer) {
+                    if (timer->type_ == TimerType::Repetitive && timer->numRepetitions_ != 1) {
+                        // A timer with a pending restart is left unlinked, it is linked into it's new slot when the
+                        // restart is drained
+                        auto control = timer->control_.load(std::memory_order_acquire);
+                        if(GetState(control) != TimerState::Running || (control & RESTART_FLAGS)) {
+                            timer->linked_ = false;
+                            numTimers_--;
+                            return false;
                         }
+                        if(timer->numRepetitions_ > 0)
+                            timer->numRepetitions_--;
+                        timer->refCount_.fetch_add(1, std::memory_order_relaxed);
+                        ScheduleNextRepetition(timer);
+                        timer->deadlineTick_ = std::max(timer->deadlineTick_, currentTick_ + 1);
+                        timer->expiryTick_ = std::max(timer->expiryTick_, currentTick_ + 1);
+                        LinkTimer(timer);
+                        return true;
                     }
 
-                    // All timers must have been expired, and now no more exist!
-                    return;
+                    // A single-shot timer (or the last repetition of a repetitive timer) is finished. This races with
+                    // RemoveTimer() and RestartTimer(), whichever changes the control word first wins. If this does,
+                    // the wheel's reference is handed over to the callback
+                    timer->linked_ = false;
+                    numTimers_--;
+                    auto control = timer->control_.load(std::memory_order_acquire);
+                    do {
+                        if(GetState(control) != TimerState::Running || (control & RESTART_FLAGS))
+                            return false;
+                    } while(!timer->control_.compare_exchange_weak(
+                            control, MakeControl(NextGeneration(GetGeneration(control)), TimerState::Finished)));
+                    return true;
+                }
+
+                /// \brief      Calculates the next deadline of a repetitive timer which has just expired. The next deadline
+                ///             is one duration after the deadline that just expired, unless that has already passed, in
+                ///             which case the timer's MissedTickPolicy decides.
+                /// \warning       Only call from the timer wheel thread.
+                void ScheduleNextRepetition(Timer* timer) {
+                    auto deadline = timer->startTime_ + timer->duration_;
+                    auto currTime = Now();
+                    if(timer->duration_.count() == 0 || timer->missedTickPolicy_ == MissedTickPolicy::Burst ||
+                       deadline + timer->duration_ > currTime) {
+                        CalculateExpiry(timer, deadline);
+                        return;
+                    }
+
+                    // The number of deadlines after the one that just expired which have already passed
+                    auto numMissedTicks = static_cast<uint64_t>((currTime - deadline) / timer->duration_);
+                    if(timer->missedTickPolicy_ == MissedTickPolicy::Skip)
+                        CalculateExpiry(timer, deadline + timer->duration_ * numMissedTicks);
+                    else
+                        CalculateExpiry(timer, currTime);
+
+                    timer->numMissedTicks_.store(timer->numMissedTicks_.load(std::memory_order_relaxed) + numMissedTicks,
+                                                 std::memory_order_relaxed);
+                    numMissedTicks_.fetch_add(numMissedTicks, std::memory_order_relaxed);
                 }
 
                 std::thread thread_;
-                std::condition_variable cv_;
+
+                /// \brief      Only used to wait for the executor callbacks to finish on destruction.
                 std::mutex mutex_;
-                bool wakeup_;
 
-                std::deque<std::shared_ptr<Timer>> timers_;
+                /// \brief      The timer wheel thread sleeps on this until the next tick it needs to process.
+                Waiter waiter_;
+
+                /// \brief      The duration of one tick of the wheel.
+                Clock::duration tickDuration_;
+
+                /// \brief      The number of levels in the wheel.
+                uint32_t numLevels_;
+
+                /// \brief      The time point that tick 0 of the wheel corresponds to.
+                Clock::time_point startTime_;
+
+                //==============================================//
+                //============ SHARED BETWEEN THREADS ==========//
+                //==============================================//
+
+                /// \brief      Timers which have been added but not linked into the wheel yet, as an intrusive
+                ///             lock-free stack (through Timer::addNext_).
+                std::atomic<Timer*> addInbox_{nullptr};
+
+                /// \brief      Timers which have been removed but not unlinked from the wheel yet, as an intrusive
+                ///             lock-free stack (through Timer::cancelNext_).
+                std::atomic<Timer*> cancelInbox_{nullptr};
+
+                /// \brief      Timers which have been restarted but not moved to their new slot yet, as an intrusive
+                ///             lock-free stack (through Timer::restartNext_).
+                std::atomic<Timer*> restartInbox_{nullptr};
+
+                /// \brief      The tick the timer wheel thread is sleeping until (UINT64_MAX if it is waiting
+                ///             indefinitely).
+                std::atomic<uint64_t> scheduledTick_{UINT64_MAX};
+
+                /// \brief      Owns all timers, in chunks of POOL_CHUNK_SIZE. Only used when growing the pool, and
+                ///             protected by poolMutex_.
+                std::vector<std::unique_ptr<Timer[]>> pool_;
+                std::mutex poolMutex_;
+
+                /// \brief      The chunks in pool_, in a fixed size table so they can be found without locking.
+                ///             TimerHandles index directly into this.
+                std::unique_ptr<std::atomic<Timer*>[]> poolChunks_;
+
+                /// \brief      The head of the list of free timers in the pool. See AllocateTimer().
+                std::atomic<uint64_t> freeHead_{NO_TIMER};
+
+                /// \brief      See GetNumWakeupsSaved().
+                std::atomic<uint64_t> numWakeupsSaved_{0};
+
+                /// \brief      Statistics returned by GetStats(). The histograms are recorded in whichever thread runs
+                ///             the callbacks, the rest are only written by the timer wheel thread (apart from
+                ///             lockWaitTime_).
+                Log2Histogram lateness_;
+                Log2Histogram callbackDuration_;
+                std::atomic<std::size_t> statsNumTimers_{0};
+                std::atomic<std::size_t> statsNumTimersInLevel_[MAX_NUM_LEVELS] = {};
+                std::atomic<uint64_t> numWakeups_{0};
+                std::atomic<int64_t> lockWaitTime_{0};
+
+                /// \brief      The total number of missed deadlines of repetitive timers, see GetNumMissedTicks().
+                std::atomic<uint64_t> numMissedTicks_{0};
+
+                /// \brief      Runs the expired timer callbacks. If nullptr, they are run on the timer wheel thread.
+                std::shared_ptr<Executor> executor_;
+
+                /// \brief      Where the time is read from. If nullptr, std::chrono::steady_clock is used.
+                std::shared_ptr<ClockSource> clockSource_;
+
+                /// \brief      Set if clockSource_ is a ManualClock, in which case there is no timer wheel thread.
+                std::shared_ptr<ManualClock> manualClock_;
+
+                /// \brief      The seq_ to give to the next timer added, only used with a manual clock.
+                std::atomic<uint64_t> nextSeq_{0};
+
+                /// \brief      The number of callbacks that have been given to the executor but have not finished
+                ///             running yet. The destructor waits for this to reach 0. Protected by mutex_.
+                std::size_t numExecutorCallbacks_ = 0;
+                std::condition_variable executorCallbacksDone_;
+
+                std::atomic<bool> exit_{false};
+
+                //==============================================//
+                //=========== TIMER WHEEL THREAD ONLY ==========//
+                //==============================================//
+
+                /// \brief      The last tick that has been processed by the wheel.
+                uint64_t currentTick_ = 0;
+
+                /// \brief      The heads of the timer lists for each slot, indexed by [level * SLOTS_PER_LEVEL + slot].
+                std::vector<Timer*> slots_;
+
+                /// \brief      Bit n of word [level * OCCUPIED_WORDS_PER_LEVEL + n / 64] is set while slot n of the
+                ///             level has timers in it, so FindNextTick() can find the next occupied slot with count
+                ///             trailing zeros.
+                std::vector<uint64_t> occupiedSlots_;
+
+                /// \brief      The number of timers linked into each level.
+                std::vector<std::size_t> numTimersInLevel_;
+
+                /// \brief      The number of timers linked into the wheel.
+                std::size_t numTimers_ = 0;
+
+                /// \brief      Timers which have expired, but have not had their callbacks called yet.
+                std::vector<ExpiredTimer> expiredTimers_;
 
-                bool exit_ = false;
+                /// \brief      The deadline ticks of the timers that expired on the tick being processed, used for
+                ///             counting the wakeups saved by coalescing.
+                std::vector<uint64_t> deadlineTicks_;
 
 
             };
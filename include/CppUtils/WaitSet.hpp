@@ -0,0 +1,210 @@
+///
+/// \file 				WaitSet.hpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains the Waitable and WaitSet classes.
+/// \details
+///		See README.md in root dir for more info.
+
+#ifndef MN_CPP_UTILS_WAIT_SET_H_
+#define MN_CPP_UTILS_WAIT_SET_H_
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// User includes
+#include "Futex.hpp"
+
+namespace mn {
+    namespace CppUtils {
+
+        class WaitSet;
+
+        /// \brief      Base class for anything a WaitSet can wait on (Semaphore, FutexSemaphore, ThreadSafeQueue and
+        ///             MsgQueue).
+        /// \details    A derived class must provide a bool IsReady() method (true if taking an item would not block),
+        ///             and call NotifyWaitSets() after anything which could make IsReady() true. When no WaitSet is
+        ///             attached, NotifyWaitSets() is a single atomic load.
+        class Waitable {
+        public:
+
+            Waitable() {}
+
+            Waitable(const Waitable&) = delete;
+            Waitable& operator=(const Waitable&) = delete;
+
+        protected:
+
+            /// \brief      Wakes up any threads waiting on a WaitSet this has been added to.
+            /// \note       Thread-safe and re-entrant.
+            inline void NotifyWaitSets();
+
+            /// \returns    True if this has been added to a WaitSet.
+            bool HasWaitSets() const {
+                return numWaitSets_.load(std::memory_order_seq_cst) != 0;
+            }
+
+        private:
+
+            friend class WaitSet;
+
+            void Attach(WaitSet* waitSet) {
+                std::lock_guard<std::mutex> lock(waitSetsMutex_);
+                waitSets_.push_back(waitSet);
+                numWaitSets_.store(static_cast<uint32_t>(waitSets_.size()), std::memory_order_seq_cst);
+            }
+
+            void Detach(WaitSet* waitSet) {
+                std::lock_guard<std::mutex> lock(waitSetsMutex_);
+                waitSets_.erase(std::remove(waitSets_.begin(), waitSets_.end(), waitSet), waitSets_.end());
+                numWaitSets_.store(static_cast<uint32_t>(waitSets_.size()), std::memory_order_seq_cst);
+            }
+
+            std::mutex waitSetsMutex_;
+            std::vector<WaitSet*> waitSets_;
+
+            /// \brief      The size of waitSets_, so NotifyWaitSets() does not need to take the lock when it is 0.
+            std::atomic<uint32_t> numWaitSets_{0};
+        };
+
+        /// \brief      Lets one thread block on several Waitable sources at once (like select() or poll(), but for
+        ///             semaphores and queues), and tells it which one became ready.
+        /// \details    This is an eventcount: every notification of an added source increments an epoch, and
+        ///             WaitAny() reads the epoch, checks the sources, and only sleeps (on a futex) if none are ready
+        ///             and the epoch has not changed since. A notification between the check and the sleep is
+        ///             therefore never lost, and sources which are not being waited on cost their notifier one extra
+        ///             atomic load.
+        ///             WaitAny() only reports that a source is ready, it does not take anything from it. If other
+        ///             threads also take from the source, use a non-blocking TryWait()/TryPop() with a 0 timeout on
+        ///             the returned source and call WaitAny() again if it fails. Sources are checked round-robin, so a
+        ///             busy source cannot starve the others.
+        ///             All sources must outlive the WaitSet. This class is neither movable nor copyable.
+        class WaitSet {
+        public:
+
+            WaitSet() {}
+
+            WaitSet(const WaitSet&) = delete;
+            WaitSet& operator=(const WaitSet&) = delete;
+
+            ~WaitSet() {
+                for(auto& source : sources_)
+                    source.waitable_->Detach(this);
+            }
+
+            /// \brief      Adds a source to wait on.
+            /// \returns    The index of the source, which WaitAny() returns when it is ready. Sources are numbered
+            ///             from 0 in the order they are added.
+            /// \warning    Not thread-safe with WaitAny() or with the source being notified, add all the sources
+            ///             during setup.
+            template<typename T>
+            std::size_t Add(T& source) {
+                static_assert(std::is_base_of<Waitable, T>::value, "WaitSet sources must derive from Waitable.");
+                sources_.push_back(Source{ &source, &source, [](void* source) {
+                    return static_cast<T*>(source)->IsReady();
+                }});
+                static_cast<Waitable&>(source).Attach(this);
+                return sources_.size() - 1;
+            }
+
+            /// \brief      Blocks indefinitely until one of the sources is ready.
+            /// \returns    The index of the ready source.
+            /// \note       Thread-safe and re-entrant.
+            std::size_t WaitAny() {
+                numWaiters_.fetch_add(1, std::memory_order_seq_cst);
+                std::size_t index;
+                while(true) {
+                    auto epoch = epoch_.load(std::memory_order_seq_cst);
+                    if(FindReady(index))
+                        break;
+                    Futex::Wait(epoch_, epoch);
+                }
+                numWaiters_.fetch_sub(1, std::memory_order_relaxed);
+                return index;
+            }
+
+            /// \brief      Blocks until either one of the sources is ready or a timeout occurs.
+            /// \param[out] index   Set to the index of the ready source.
+            /// \returns    True if a source was ready before the timeout occurred, otherwise false.
+            /// \note       Thread-safe and re-entrant.
+            bool TryWaitAny(std::size_t& index, std::chrono::milliseconds timeout) {
+                auto deadline = std::chrono::steady_clock::now() + timeout;
+                numWaiters_.fetch_add(1, std::memory_order_seq_cst);
+                bool ready;
+                while(true) {
+                    auto epoch = epoch_.load(std::memory_order_seq_cst);
+                    if((ready = FindReady(index)))
+                        break;
+                    if(!Futex::WaitFor(epoch_, epoch, deadline - std::chrono::steady_clock::now())) {
+                        ready = FindReady(index);
+                        break;
+                    }
+                }
+                numWaiters_.fetch_sub(1, std::memory_order_relaxed);
+                return ready;
+            }
+
+            /// \returns    The number of sources added.
+            std::size_t Size() const {
+                return sources_.size();
+            }
+
+        private:
+
+            friend class Waitable;
+
+            struct Source {
+                Waitable* waitable_;
+                void* source_;
+                bool (*isReady_)(void*);
+            };
+
+            /// \brief      Called by the sources when they may have become ready.
+            void Signal() {
+                epoch_.fetch_add(1, std::memory_order_seq_cst);
+                if(numWaiters_.load(std::memory_order_seq_cst) != 0)
+                    Futex::WakeAll(epoch_);
+            }
+
+            /// \brief      Checks every source once, starting after the one found last time.
+            bool FindReady(std::size_t& index) {
+                auto numSources = sources_.size();
+                auto start = next_.load(std::memory_order_relaxed);
+                for(std::size_t i = 0; i < numSources; i++) {
+                    auto candidate = (start + i) % numSources;
+                    if(sources_[candidate].isReady_(sources_[candidate].source_)) {
+                        next_.store(candidate + 1, std::memory_order_relaxed);
+                        index = candidate;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::vector<Source> sources_;
+            std::atomic<uint32_t> epoch_{0};
+            std::atomic<uint32_t> numWaiters_{0};
+            std::atomic<std::size_t> next_{0};
+        };
+
+        void Waitable::NotifyWaitSets() {
+            if(!HasWaitSets())
+                return;
+            std::lock_guard<std::mutex> lock(waitSetsMutex_);
+            for(auto waitSet : waitSets_)
+                waitSet->Signal();
+        }
+
+    } // namespace CppUtils
+} // namespace mn
+
+#endif // MN_CPP_UTILS_WAIT_SET_H_
@@ -0,0 +1,212 @@
+///
+/// \file 				AsyncEventTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the AsyncEvent class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/AsyncEvent.hpp"
+#include "CppUtils/Semaphore.hpp"
+
+using namespace mn::CppUtils;
+
+namespace {
+
+    class AsyncEventTests : public ::testing::Test {
+    protected:
+        AsyncEventTests() {}
+        virtual ~AsyncEventTests() {}
+    };
+
+    TEST_F(AsyncEventTests, ListenersRunOnExecutor) {
+        AsyncEvent<void(std::string)> event(std::make_shared<ThreadPoolExecutor>(1));
+
+        std::string received;
+        std::thread::id listenerThreadId;
+        event.AddListener([&](std::string msg) {
+            received = msg;
+            listenerThreadId = std::this_thread::get_id();
+        });
+
+        event.Fire("hello");
+        event.Flush();
+        EXPECT_EQ("hello", received);
+        EXPECT_NE(std::this_thread::get_id(), listenerThreadId);
+    }
+
+    TEST_F(AsyncEventTests, EveryFireDeliveredInOrder) {
+        AsyncEvent<void(int)> event(std::make_shared<ThreadPoolExecutor>(4));
+
+        std::vector<int> received;
+        event.AddListener([&](int value) {
+            received.push_back(value);
+        });
+
+        for(int i = 0; i < 1000; i++)
+            event.Fire(i);
+        event.Flush();
+
+        ASSERT_EQ(1000u, received.size());
+        for(int i = 0; i < 1000; i++)
+            EXPECT_EQ(i, received[i]);
+        EXPECT_EQ(1000u, event.GetNumFires());
+        EXPECT_EQ(1000u, event.GetNumDeliveries());
+    }
+
+    TEST_F(AsyncEventTests, LastValueWins) {
+        AsyncEvent<void(int)> event(std::make_shared<ThreadPoolExecutor>(1), CoalescePolicy::LastValueWins);
+
+        // Block the first delivery, so the following fires have to be coalesced
+        Semaphore started;
+        Semaphore release;
+        std::vector<int> received;
+        event.AddListener([&](int value) {
+            received.push_back(value);
+            if(value == 0) {
+                started.Notify();
+                release.Wait();
+            }
+        });
+
+        event.Fire(0);
+        started.Wait();
+        for(int i = 1; i <= 100; i++)
+            event.Fire(i);
+        release.Notify();
+        event.Flush();
+
+        ASSERT_EQ(2u, received.size());
+        EXPECT_EQ(0, received[0]);
+        EXPECT_EQ(100, received[1]);
+        EXPECT_EQ(101u, event.GetNumFires());
+        EXPECT_EQ(2u, event.GetNumDeliveries());
+    }
+
+    TEST_F(AsyncEventTests, Accumulate) {
+        AsyncEvent<void(int)> event(std::make_shared<ThreadPoolExecutor>(1),
+                                    [](std::tuple<int>& pending, std::tuple<int>&& incoming) {
+            std::get<0>(pending) += std::get<0>(incoming);
+        });
+
+        Semaphore started;
+        Semaphore release;
+        std::vector<int> received;
+        event.AddListener([&](int value) {
+            received.push_back(value);
+            if(received.size() == 1) {
+                started.Notify();
+                release.Wait();
+            }
+        });
+
+        event.Fire(1);
+        started.Wait();
+        for(int i = 0; i < 100; i++)
+            event.Fire(2);
+        release.Notify();
+        event.Flush();
+
+        ASSERT_EQ(2u, received.size());
+        EXPECT_EQ(1, received[0]);
+        EXPECT_EQ(200, received[1]);
+    }
+
+    TEST_F(AsyncEventTests, FireFromListener) {
+        AsyncEvent<void(int)> event(std::make_shared<ThreadPoolExecutor>(2));
+
+        std::atomic<int> sum(0);
+        event.AddListener([&](int value) {
+            sum += value;
+            if(value > 0)
+                event.Fire(value - 1);
+        });
+
+        event.Fire(10);
+        // Flush() also waits for fires made by the listeners
+        event.Flush();
+        EXPECT_EQ(55, sum.load());
+    }
+
+    TEST_F(AsyncEventTests, AddAndRemoveListenersWhileDelivering) {
+        AsyncEvent<void(int)> event(std::make_shared<ThreadPoolExecutor>(2));
+
+        // Every listener checks the state it captured, which would be garbage if it was called from a freed list
+        std::atomic<int> numBadCalls(0);
+        auto makeListener = [&]() {
+            auto values = std::vector<int>(16, 7);
+            return [&numBadCalls, values](int value) {
+                if(values.size() != 16 || values[value % 16] != 7)
+                    numBadCalls++;
+            };
+        };
+        event.AddListener(makeListener());
+        event.AddListener([&](int value) {
+            if(value % 64 == 0)
+                event.RemoveListener(event.AddListener(makeListener()));
+        });
+
+        std::atomic<bool> stop(false);
+        std::thread writer([&]() {
+            std::vector<ListenerId> ids;
+            while(!stop) {
+                for(int i = 0; i < 4; i++)
+                    ids.push_back(event.AddListener(makeListener()));
+                for(auto id : ids)
+                    EXPECT_TRUE(event.RemoveListener(id));
+                ids.clear();
+            }
+        });
+
+        std::vector<std::thread> producers;
+        for(int i = 0; i < 2; i++) {
+            producers.emplace_back([&]() {
+                for(int j = 0; j < 5000; j++)
+                    event.Fire(j);
+            });
+        }
+        for(auto& producer : producers)
+            producer.join();
+        event.Flush();
+        stop = true;
+        writer.join();
+
+        EXPECT_EQ(0, numBadCalls.load());
+        EXPECT_EQ(10000u, event.GetNumDeliveries());
+    }
+
+    TEST_F(AsyncEventTests, DestroyDeliversQueuedFires) {
+        auto executor = std::make_shared<ThreadPoolExecutor>(1);
+        std::atomic<int> numCalls(0);
+        {
+            AsyncEvent<void()> event(executor);
+            event.AddListener([&]() { numCalls++; });
+            for(int i = 0; i < 100; i++)
+                event.Fire();
+        }
+        EXPECT_EQ(100, numCalls.load());
+    }
+
+    TEST_F(AsyncEventTests, InvalidArgumentsExceptionTest) {
+        EXPECT_THROW(AsyncEvent<void()>(nullptr), std::invalid_argument);
+        EXPECT_THROW(AsyncEvent<void()>(std::make_shared<ThreadPoolExecutor>(1), CoalescePolicy::Accumulate),
+                     std::invalid_argument);
+        EXPECT_THROW(AsyncEvent<void()>(std::make_shared<ThreadPoolExecutor>(1), AsyncEvent<void()>::Accumulator()),
+                     std::invalid_argument);
+    }
+
+}  // namespace
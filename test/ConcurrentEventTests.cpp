@@ -0,0 +1,260 @@
+///
+/// \file 				ConcurrentEventTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the ConcurrentEvent class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/ConcurrentEvent.hpp"
+#include "CppUtils/HeapTracker.hpp"
+
+using namespace mn::CppUtils;
+
+namespace {
+
+    class ConcurrentEventTests : public ::testing::Test {
+    protected:
+        ConcurrentEventTests() {}
+        virtual ~ConcurrentEventTests() {}
+    };
+
+    TEST_F(ConcurrentEventTests, BasicLambda) {
+        ConcurrentEvent<void(std::string)> event;
+
+        std::vector<std::string> msgs;
+        event.AddListener([&](std::string msg) {
+            msgs.push_back(std::move(msg));
+        });
+        event.AddListener([&](std::string msg) {
+            msgs.push_back(std::move(msg));
+        });
+
+        event.Fire(std::string("Hello"));
+        EXPECT_EQ(std::vector<std::string>({ "Hello", "Hello" }), msgs);
+    }
+
+    TEST_F(ConcurrentEventTests, RvalueReferenceListeners) {
+        ConcurrentEvent<void(std::string&&)> event;
+
+        std::vector<std::string> msgs;
+        for(int i = 0; i < 2; i++) {
+            event.AddListener([&](std::string&& msg) {
+                msgs.push_back(std::move(msg));
+            });
+        }
+
+        event.Fire(std::string("Hello"));
+        std::string msg("World");
+        event.Fire(msg);
+        EXPECT_EQ(std::vector<std::string>({ "Hello", "Hello", "World", "World" }), msgs);
+        EXPECT_EQ("World", msg);
+    }
+
+    TEST_F(ConcurrentEventTests, RemoveListener) {
+        ConcurrentEvent<void()> event;
+
+        int counter0 = 0;
+        int counter1 = 0;
+        auto id0 = event.AddListener([&]() { counter0++; });
+        event.AddListener([&]() { counter1++; });
+        EXPECT_EQ(2u, event.GetNumListeners());
+
+        EXPECT_TRUE(event.RemoveListener(id0));
+        EXPECT_FALSE(event.RemoveListener(id0));
+        event.Fire();
+        EXPECT_EQ(0, counter0);
+        EXPECT_EQ(1, counter1);
+
+        event.RemoveAllListeners();
+        event.Fire();
+        EXPECT_EQ(1, counter1);
+        EXPECT_EQ(0u, event.GetNumListeners());
+    }
+
+    TEST_F(ConcurrentEventTests, ListenerCanRemoveItself) {
+        ConcurrentEvent<void()> event;
+
+        int counter = 0;
+        ListenerId id;
+        id = event.AddListener([&]() {
+            counter++;
+            EXPECT_TRUE(event.RemoveListener(id));
+        });
+
+        // Must not deadlock waiting for the fire it is called from
+        event.Fire();
+        event.Fire();
+        EXPECT_EQ(1, counter);
+        EXPECT_EQ(0u, event.GetNumListeners());
+    }
+
+    TEST_F(ConcurrentEventTests, FireDoesNotAllocate) {
+        ConcurrentEvent<void(int)> event;
+        int sum = 0;
+        for(int i = 0; i < 4; i++) {
+            event.AddListener([&, i](int value) {
+                sum += value + i;
+            });
+        }
+
+        auto numAllocations = HeapTracker::Instance().GetNumAllocations();
+        for(int i = 0; i < 100; i++)
+            event.Fire(1);
+        EXPECT_EQ(numAllocations, HeapTracker::Instance().GetNumAllocations());
+        EXPECT_EQ(4 * 100 + 100 * (0 + 1 + 2 + 3), sum);
+    }
+
+    TEST_F(ConcurrentEventTests, FireWhileAddingAndRemoving) {
+        ConcurrentEvent<void(int)> event;
+
+        // A listener which is always attached, and one which is added and removed over and over
+        std::atomic<int> numPermanentCalls(0);
+        std::atomic<int> numTransientCalls(0);
+        event.AddListener([&](int) {
+            numPermanentCalls.fetch_add(1, std::memory_order_relaxed);
+        });
+
+        constexpr int NUM_FIRE_THREADS = 3;
+        constexpr int NUM_FIRES = 20000;
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> threads;
+        for(int i = 0; i < NUM_FIRE_THREADS; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < NUM_FIRES; j++)
+                    event.Fire(j);
+            }));
+        }
+
+        std::thread writer([&]() {
+            while(!stop.load()) {
+                auto id = event.AddListener([&](int) {
+                    numTransientCalls.fetch_add(1, std::memory_order_relaxed);
+                });
+                event.RemoveListener(id);
+            }
+        });
+
+        for(auto& thread : threads)
+            thread.join();
+        stop.store(true);
+        writer.join();
+
+        // Every fire saw the permanent listener, whatever the writer was doing at the time
+        EXPECT_EQ(NUM_FIRE_THREADS * NUM_FIRES, numPermanentCalls.load());
+        EXPECT_LE(numTransientCalls.load(), NUM_FIRE_THREADS * NUM_FIRES);
+        EXPECT_EQ(1u, event.GetNumListeners());
+    }
+
+    TEST_F(ConcurrentEventTests, ListsNotFreedWhileFiring) {
+        ConcurrentEvent<void(int)> event;
+
+        // Every listener owns heap memory and checks it on every call, so a fire using a freed list fails (or is
+        // caught by AddressSanitizer)
+        std::atomic<int> numBadCalls(0);
+        auto makeListener = [&]() {
+            std::vector<int> values(16, 7);
+            return [&numBadCalls, values](int) {
+                for(auto value : values) {
+                    if(value != 7)
+                        numBadCalls.fetch_add(1, std::memory_order_relaxed);
+                }
+            };
+        };
+        event.AddListener(makeListener());
+
+        // Also adds and removes a listener from inside a listener, where the writer cannot wait for readers
+        event.AddListener([&](int value) {
+            if(value % 64 == 0)
+                event.RemoveListener(event.AddListener(makeListener()));
+        });
+
+        constexpr int NUM_FIRE_THREADS = 3;
+        constexpr int NUM_FIRES = 20000;
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> threads;
+        for(int i = 0; i < NUM_FIRE_THREADS; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < NUM_FIRES; j++)
+                    event.Fire(j);
+            }));
+        }
+
+        std::thread writer([&]() {
+            std::vector<ListenerId> ids;
+            while(!stop.load()) {
+                ids.push_back(event.AddListener(makeListener()));
+                if(ids.size() == 4) {
+                    for(auto id : ids)
+                        event.RemoveListener(id);
+                    ids.clear();
+                }
+            }
+        });
+
+        for(auto& thread : threads)
+            thread.join();
+        stop.store(true);
+        writer.join();
+
+        EXPECT_EQ(0, numBadCalls.load());
+    }
+
+    TEST_F(ConcurrentEventTests, ManyWritersFinishWhileFiring) {
+        ConcurrentEvent<void()> event;
+        std::atomic<int> numCalls(0);
+        event.AddListener([&]() { numCalls++; });
+
+        // Fire non-stop, so the writers waiting out grace periods at the same time must not hold each other up
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> fireThreads;
+        for(int i = 0; i < 2; i++) {
+            fireThreads.emplace_back([&]() {
+                while(!stop)
+                    event.Fire();
+            });
+        }
+
+        std::vector<std::thread> writers;
+        for(int i = 0; i < 4; i++) {
+            writers.emplace_back([&]() {
+                for(int j = 0; j < 200; j++)
+                    EXPECT_TRUE(event.RemoveListener(event.AddListener([]() {})));
+            });
+        }
+        for(auto& writer : writers)
+            writer.join();
+        stop = true;
+        for(auto& fireThread : fireThreads)
+            fireThread.join();
+
+        EXPECT_EQ(1u, event.GetNumListeners());
+        EXPECT_GT(numCalls.load(), 0);
+    }
+
+    TEST_F(ConcurrentEventTests, SubscriptionRemovesListenerOnDestruction) {
+        ConcurrentEvent<void()> event;
+
+        int counter = 0;
+        {
+            auto subscription = event.Subscribe([&]() { counter++; });
+            event.Fire();
+        }
+        event.Fire();
+        EXPECT_EQ(1, counter);
+        EXPECT_EQ(0u, event.GetNumListeners());
+    }
+
+}  // namespace
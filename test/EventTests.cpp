@@ -3,19 +3,22 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-08-14
-/// \last-modified		2017-08-14
+/// \last-modified		2026-10-17
 /// \brief 				Contains tests for the Event class.
 /// \details
 ///		See README.md in root dir for more info.
 
 // System includes
-// nothing
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // 3rd party includes
 #include "gtest/gtest.h"
 
 // User includes
 #include "CppUtils/Event.hpp"
+#include "CppUtils/HeapTracker.hpp"
 
 using namespace mn::CppUtils;
 
@@ -57,4 +60,186 @@ namespace {
         EXPECT_EQ(true, testClass.methodCalled_);
     }
 
+    TEST_F(EventTests, EveryListenerGetsSameParameters) {
+        Event<void(std::string)> event;
+
+        // Listeners taking the parameter by value may move from it, which must not affect the next listener
+        std::vector<std::string> msgs;
+        for(int i = 0; i < 3; i++) {
+            event.AddListener([&](std::string msg) {
+                msgs.push_back(std::move(msg));
+            });
+        }
+
+        event.Fire(std::string("Hello"));
+        EXPECT_EQ(std::vector<std::string>({ "Hello", "Hello", "Hello" }), msgs);
+    }
+
+    TEST_F(EventTests, RvalueReferenceListeners) {
+        Event<void(std::string&&)> event;
+
+        // Each listener gets it's own copy to move from
+        std::vector<std::string> msgs;
+        for(int i = 0; i < 3; i++) {
+            event.AddListener([&](std::string&& msg) {
+                msgs.push_back(std::move(msg));
+            });
+        }
+
+        event.Fire(std::string("Hello"));
+        std::string msg("World");
+        event.Fire(msg);
+        EXPECT_EQ(std::vector<std::string>({ "Hello", "Hello", "Hello", "World", "World", "World" }), msgs);
+        EXPECT_EQ("World", msg);
+    }
+
+    /// \brief      A listener which counts how many times it is copied.
+    class CopyCountingListener {
+    public:
+        CopyCountingListener(int& numCopies) : numCopies_(numCopies) {}
+        CopyCountingListener(const CopyCountingListener& other) : numCopies_(other.numCopies_) {
+            numCopies_++;
+        }
+        void operator()(int) {}
+    private:
+        int& numCopies_;
+        char padding_[64] = {};
+    };
+
+    TEST_F(EventTests, FireDoesNotCopyOrAllocate) {
+        Event<void(int)> event;
+        int numCopies = 0;
+        for(int i = 0; i < 4; i++)
+            event.AddListener(CopyCountingListener(numCopies));
+
+        numCopies = 0;
+        auto numAllocations = HeapTracker::Instance().GetNumAllocations();
+        for(int i = 0; i < 100; i++)
+            event.Fire(i);
+        EXPECT_EQ(numAllocations, HeapTracker::Instance().GetNumAllocations());
+        EXPECT_EQ(0, numCopies);
+    }
+
+    TEST_F(EventTests, RemoveListenerById) {
+        Event<void()> event;
+
+        int counters[3] = { 0, 0, 0 };
+        ListenerId ids[3];
+        for(int i = 0; i < 3; i++)
+            ids[i] = event.AddListener([&, i]() { counters[i]++; });
+
+        EXPECT_TRUE(event.RemoveListener(ids[1]));
+        EXPECT_EQ(2u, event.GetNumListeners());
+        event.Fire();
+        EXPECT_EQ(1, counters[0]);
+        EXPECT_EQ(0, counters[1]);
+        EXPECT_EQ(1, counters[2]);
+
+        // The ID of the listener moved into the gap must still work
+        EXPECT_TRUE(event.RemoveListener(ids[2]));
+        event.Fire();
+        EXPECT_EQ(2, counters[0]);
+        EXPECT_EQ(1, counters[2]);
+    }
+
+    TEST_F(EventTests, StaleIdDoesNotRemoveNewListener) {
+        Event<void()> event;
+
+        auto oldId = event.AddListener([]() {});
+        EXPECT_TRUE(event.RemoveListener(oldId));
+        EXPECT_FALSE(event.RemoveListener(oldId));
+        EXPECT_FALSE(event.RemoveListener(ListenerId()));
+
+        // Reuses the slot of the removed listener
+        bool called = false;
+        auto newId = event.AddListener([&]() { called = true; });
+        EXPECT_NE(oldId, newId);
+        EXPECT_FALSE(event.RemoveListener(oldId));
+        event.Fire();
+        EXPECT_TRUE(called);
+    }
+
+    TEST_F(EventTests, RemoveListenerByIndex) {
+        Event<void()> event;
+
+        int counter = 0;
+        event.AddListener([&]() { counter += 1; });
+        event.AddListener([&]() { counter += 10; });
+        event.RemoveListener(0u);
+        event.Fire();
+        EXPECT_EQ(10, counter);
+
+        EXPECT_THROW(event.RemoveListener(1u), std::invalid_argument);
+    }
+
+    TEST_F(EventTests, RemoveListenerByIndexKeepsOrder) {
+        Event<void()> event;
+
+        std::vector<char> calls;
+        auto idA = event.AddListener([&]() { calls.push_back('A'); });
+        event.AddListener([&]() { calls.push_back('B'); });
+        auto idC = event.AddListener([&]() { calls.push_back('C'); });
+        event.AddListener([&]() { calls.push_back('D'); });
+
+        // Removing the first listener twice removes A then B, leaving C and D in order
+        event.RemoveListener(0u);
+        event.RemoveListener(0u);
+        event.Fire();
+        EXPECT_EQ(std::vector<char>({ 'C', 'D' }), calls);
+
+        // IDs of the shifted listeners still work
+        EXPECT_FALSE(event.RemoveListener(idA));
+        EXPECT_TRUE(event.RemoveListener(idC));
+        calls.clear();
+        event.Fire();
+        EXPECT_EQ(std::vector<char>({ 'D' }), calls);
+    }
+
+    TEST_F(EventTests, SubscriptionRemovesListenerOnDestruction) {
+        Event<void()> event;
+
+        int counter = 0;
+        {
+            auto subscription = event.Subscribe([&]() { counter++; });
+            EXPECT_TRUE(subscription.IsSubscribed());
+            event.Fire();
+
+            std::vector<Subscription> subscriptions;
+            subscriptions.push_back(std::move(subscription));
+            EXPECT_FALSE(subscription.IsSubscribed());
+            event.Fire();
+            EXPECT_EQ(2, counter);
+        }
+        event.Fire();
+        EXPECT_EQ(2, counter);
+        EXPECT_EQ(0u, event.GetNumListeners());
+
+        auto subscription = event.Subscribe([&]() { counter++; });
+        subscription.Unsubscribe();
+        EXPECT_FALSE(subscription.IsSubscribed());
+        event.Fire();
+        EXPECT_EQ(2, counter);
+    }
+
+    TEST_F(EventTests, RemoveManyListenersById) {
+        Event<void(int&)> event;
+
+        const int numListeners = 10000;
+        std::vector<ListenerId> ids;
+        for(int i = 0; i < numListeners; i++)
+            ids.push_back(event.AddListener([](int& count) { count++; }));
+
+        // Removing from the front used to shift every other listener each time
+        for(int i = 0; i < numListeners / 2; i++)
+            EXPECT_TRUE(event.RemoveListener(ids[i]));
+
+        int count = 0;
+        event.Fire(count);
+        EXPECT_EQ(numListeners / 2, count);
+
+        event.RemoveAllListeners();
+        for(auto id : ids)
+            EXPECT_FALSE(event.RemoveListener(id));
+    }
+
 }  // namespace
\ No newline at end of file
@@ -0,0 +1,69 @@
+///
+/// \file 				ExecutorTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the Executor classes.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/Executor.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils;
+
+namespace {
+
+    class ExecutorTests : public ::testing::Test {
+    protected:
+        ExecutorTests() {}
+        virtual ~ExecutorTests() {}
+    };
+
+    TEST_F(ExecutorTests, TasksRunOnWorkerThread) {
+        ThreadPoolExecutor executor(1);
+
+        std::atomic<bool> ranOnOtherThread(false);
+        auto callerThreadId = std::this_thread::get_id();
+
+        executor.Execute([&]() {
+            ranOnOtherThread.store(std::this_thread::get_id() != callerThreadId);
+        });
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_TRUE(ranOnOtherThread.load());
+    }
+
+    TEST_F(ExecutorTests, AllTasksRunBeforeDestruction) {
+        std::atomic<int> counter(0);
+
+        {
+            ThreadPoolExecutor executor(4);
+            for(int i = 0; i < 1000; i++) {
+                executor.Execute([&]() {
+                    counter.fetch_add(1);
+                });
+            }
+        } // Executor is destroyed here
+
+        EXPECT_EQ(1000, counter.load());
+    }
+
+    TEST_F(ExecutorTests, InvalidArgumentsExceptionTest) {
+        EXPECT_THROW(ThreadPoolExecutor(0), std::invalid_argument);
+
+        ThreadPoolExecutor executor(1);
+        EXPECT_THROW(executor.Execute(std::function<void()>()), std::invalid_argument);
+    }
+
+}  // namespace
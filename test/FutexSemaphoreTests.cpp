@@ -0,0 +1,217 @@
+///
+/// \file 				FutexSemaphoreTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the FutexSemaphore class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/FutexSemaphore.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils;
+
+namespace {
+
+    class FutexSemaphoreTests : public ::testing::Test {
+    protected:
+        FutexSemaphoreTests() {}
+        virtual ~FutexSemaphoreTests() {}
+    };
+
+    TEST_F(FutexSemaphoreTests, SingleThreadNotifyThenWait) {
+        FutexSemaphore semaphore;
+        semaphore.Notify();
+        semaphore.Wait();
+    }
+
+    TEST_F(FutexSemaphoreTests, WaitBlocksUntilNotify) {
+        FutexSemaphore semaphore;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread t1([&]() {
+            std::this_thread::sleep_for(100ms);
+            semaphore.Notify();
+        });
+
+        semaphore.Wait();
+
+        auto duration = std::chrono::steady_clock::now() - start;
+        EXPECT_GE(duration, 100ms);
+        EXPECT_LT(duration, 200ms);
+
+        t1.join();
+    }
+
+    TEST_F(FutexSemaphoreTests, TryWaitNoNotify) {
+        FutexSemaphore semaphore;
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(semaphore.TryWait(100ms));
+        auto duration = std::chrono::steady_clock::now() - start;
+        EXPECT_GE(duration, 100ms);
+        EXPECT_LT(duration, 150ms);
+    }
+
+    TEST_F(FutexSemaphoreTests, TryWaitThreeNotifications) {
+        FutexSemaphore semaphore;
+
+        std::thread t1([&]() {
+            semaphore.Notify();
+            semaphore.Notify();
+            semaphore.Notify();
+        });
+
+        EXPECT_TRUE(semaphore.TryWait(100ms));
+        EXPECT_TRUE(semaphore.TryWait(100ms));
+        EXPECT_TRUE(semaphore.TryWait(100ms));
+        EXPECT_FALSE(semaphore.TryWait(10ms));
+
+        t1.join();
+    }
+
+    TEST_F(FutexSemaphoreTests, PingPong) {
+        FutexSemaphore ping;
+        FutexSemaphore pong;
+        constexpr int NUM_ROUND_TRIPS = 10000;
+
+        std::thread t1([&]() {
+            for(int i = 0; i < NUM_ROUND_TRIPS; i++) {
+                ping.Wait();
+                pong.Notify();
+            }
+        });
+
+        for(int i = 0; i < NUM_ROUND_TRIPS; i++) {
+            ping.Notify();
+            pong.Wait();
+        }
+
+        t1.join();
+        EXPECT_FALSE(ping.TryWait(0ms));
+        EXPECT_FALSE(pong.TryWait(0ms));
+    }
+
+    TEST_F(FutexSemaphoreTests, ManyProducersAndConsumers) {
+        FutexSemaphore semaphore;
+        constexpr int NUM_THREADS = 4;
+        constexpr int NUM_NOTIFIES_PER_THREAD = 10000;
+        std::atomic<int> numWaits(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < NUM_THREADS; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < NUM_NOTIFIES_PER_THREAD; j++) {
+                    semaphore.Wait();
+                    numWaits.fetch_add(1);
+                }
+            }));
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < NUM_NOTIFIES_PER_THREAD; j++)
+                    semaphore.Notify();
+            }));
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+
+        // Every notification was consumed exactly once
+        EXPECT_EQ(NUM_THREADS * NUM_NOTIFIES_PER_THREAD, numWaits.load());
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(FutexSemaphoreTests, NotifyCountWakesManyWaiters) {
+        FutexSemaphore semaphore;
+        constexpr int NUM_THREADS = 4;
+        std::atomic<int> numWoken(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < NUM_THREADS; i++) {
+            threads.push_back(std::thread([&]() {
+                semaphore.Wait();
+                numWoken.fetch_add(1);
+            }));
+        }
+
+        std::this_thread::sleep_for(50ms);
+        EXPECT_EQ(0, numWoken.load());
+        semaphore.Notify(NUM_THREADS);
+
+        for(auto& thread : threads)
+            thread.join();
+        EXPECT_EQ(NUM_THREADS, numWoken.load());
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(FutexSemaphoreTests, WaitCountTakesAllPermitsAtOnce) {
+        FutexSemaphore semaphore;
+        std::atomic<bool> acquired(false);
+
+        std::thread t1([&]() {
+            semaphore.Wait(3);
+            acquired.store(true);
+        });
+
+        semaphore.Notify();
+        semaphore.Notify();
+        std::this_thread::sleep_for(50ms);
+        EXPECT_FALSE(acquired.load());
+
+        semaphore.Notify();
+        t1.join();
+        EXPECT_TRUE(acquired.load());
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(FutexSemaphoreTests, TryWaitCountTimesOutWithoutTakingPermits) {
+        FutexSemaphore semaphore;
+        semaphore.Notify(2);
+
+        EXPECT_FALSE(semaphore.TryWait(3, 50ms));
+
+        // The two permits are still there
+        EXPECT_TRUE(semaphore.TryWait(2, 0ms));
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(FutexSemaphoreTests, NotifyWakesSingleWaiterBehindMultiWaiter) {
+        FutexSemaphore semaphore;
+        std::atomic<bool> multiAcquired(false);
+        std::atomic<bool> singleAcquired(false);
+
+        std::thread t1([&]() {
+            semaphore.Wait(2);
+            multiAcquired.store(true);
+        });
+        std::this_thread::sleep_for(20ms);
+        std::thread t2([&]() {
+            semaphore.Wait();
+            singleAcquired.store(true);
+        });
+        std::this_thread::sleep_for(20ms);
+
+        // One permit is not enough for the first thread, but must not be lost on it either
+        semaphore.Notify();
+        t2.join();
+        EXPECT_TRUE(singleAcquired.load());
+        EXPECT_FALSE(multiAcquired.load());
+
+        semaphore.Notify(2);
+        t1.join();
+        EXPECT_TRUE(multiAcquired.load());
+    }
+
+}  // namespace
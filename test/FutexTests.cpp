@@ -0,0 +1,68 @@
+///
+/// \file 				FutexTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the Futex class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/Futex.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils;
+
+namespace {
+
+    class FutexTests : public ::testing::Test {
+    protected:
+        FutexTests() {}
+        virtual ~FutexTests() {}
+    };
+
+    TEST_F(FutexTests, WaitReturnsIfValueDiffers) {
+        std::atomic<uint32_t> word(1);
+
+        // Would block forever if the value was not checked
+        Futex::Wait(word, 0);
+        EXPECT_TRUE(Futex::WaitFor(word, 0, 1s));
+    }
+
+    TEST_F(FutexTests, WakeWakesWaiter) {
+        std::atomic<uint32_t> word(0);
+
+        std::thread t1([&]() {
+            std::this_thread::sleep_for(50ms);
+            word.store(1);
+            Futex::WakeAll(word);
+        });
+
+        while(word.load() == 0)
+            Futex::Wait(word, 0);
+        EXPECT_EQ(1u, word.load());
+
+        t1.join();
+    }
+
+    TEST_F(FutexTests, WaitForTimesOut) {
+        std::atomic<uint32_t> word(0);
+
+        auto start = std::chrono::steady_clock::now();
+        bool woken = true;
+        while(woken && std::chrono::steady_clock::now() - start < 50ms)
+            woken = Futex::WaitFor(word, 0, 50ms - (std::chrono::steady_clock::now() - start));
+        EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+        EXPECT_FALSE(Futex::WaitFor(word, 0, 0ms));
+    }
+
+}  // namespace
@@ -0,0 +1,121 @@
+///
+/// \file 				InlineFunctionTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the InlineFunction class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <array>
+#include <functional>
+#include <memory>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/HeapTracker.hpp"
+#include "CppUtils/InlineFunction.hpp"
+
+using namespace mn::CppUtils;
+
+namespace {
+
+    class InlineFunctionTests : public ::testing::Test {
+    protected:
+        InlineFunctionTests() {}
+        virtual ~InlineFunctionTests() {}
+    };
+
+    int AddOne(int value) {
+        return value + 1;
+    }
+
+    TEST_F(InlineFunctionTests, CallLambda) {
+        int counter = 0;
+        InlineFunction<void()> function([&]() {
+            counter++;
+        });
+        EXPECT_TRUE(static_cast<bool>(function));
+        function();
+        function();
+        EXPECT_EQ(2, counter);
+    }
+
+    TEST_F(InlineFunctionTests, ArgsAndReturnValue) {
+        InlineFunction<int(int)> function(&AddOne);
+        EXPECT_EQ(3, function(2));
+
+        InlineFunction<int(int, int)> add([](int a, int b) {
+            return a + b;
+        });
+        EXPECT_EQ(5, add(2, 3));
+    }
+
+    TEST_F(InlineFunctionTests, EmptyFunction) {
+        InlineFunction<void()> function;
+        EXPECT_FALSE(static_cast<bool>(function));
+        EXPECT_THROW(function(), std::bad_function_call);
+
+        // Empty std::functions and null function pointers create empty InlineFunctions
+        InlineFunction<void()> fromStdFunction(std::function<void()>{});
+        EXPECT_FALSE(static_cast<bool>(fromStdFunction));
+        InlineFunction<int(int)> fromNullPointer(static_cast<int(*)(int)>(nullptr));
+        EXPECT_FALSE(static_cast<bool>(fromNullPointer));
+    }
+
+    TEST_F(InlineFunctionTests, Move) {
+        auto counter = std::make_shared<int>(0);
+        InlineFunction<void()> function1([counter]() {
+            (*counter)++;
+        });
+        EXPECT_EQ(2, counter.use_count());
+
+        InlineFunction<void()> function2(std::move(function1));
+        EXPECT_FALSE(static_cast<bool>(function1));
+        function2();
+        EXPECT_EQ(1, *counter);
+
+        function1 = std::move(function2);
+        function1();
+        EXPECT_EQ(2, *counter);
+
+        // The captured shared_ptr is destroyed along with the callable
+        function1.Reset();
+        EXPECT_EQ(1, counter.use_count());
+    }
+
+    TEST_F(InlineFunctionTests, SmallCallableDoesNotAllocate) {
+        int counter = 0;
+        auto numAllocations = HeapTracker::Instance().GetNumAllocations();
+        {
+            InlineFunction<void()> function1([&counter]() {
+                counter++;
+            });
+            InlineFunction<void()> function2(std::move(function1));
+            function2();
+        }
+        EXPECT_EQ(numAllocations, HeapTracker::Instance().GetNumAllocations());
+        EXPECT_EQ(1, counter);
+    }
+
+    TEST_F(InlineFunctionTests, LargeCallableStoredOnHeap) {
+        std::array<int, 32> values = {};
+        values[31] = 7;
+        auto callable = [values]() {
+            return values[31];
+        };
+        EXPECT_FALSE(InlineFunction<int()>::IsStoredInline<decltype(callable)>());
+
+        auto numAllocations = HeapTracker::Instance().GetNumAllocations();
+        InlineFunction<int()> function1(callable);
+        EXPECT_EQ(numAllocations + 1, HeapTracker::Instance().GetNumAllocations());
+
+        InlineFunction<int()> function2(std::move(function1));
+        EXPECT_EQ(7, function2());
+    }
+
+}  // namespace
@@ -0,0 +1,117 @@
+///
+/// \file 				Log2HistogramTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the Log2Histogram class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/Log2Histogram.hpp"
+
+using namespace mn::CppUtils;
+
+namespace {
+
+    class Log2HistogramTests : public ::testing::Test {
+    protected:
+        Log2HistogramTests() {}
+        virtual ~Log2HistogramTests() {}
+    };
+
+    TEST_F(Log2HistogramTests, Buckets) {
+        EXPECT_EQ(0u, Log2Histogram::GetBucket(0));
+        EXPECT_EQ(1u, Log2Histogram::GetBucket(1));
+        EXPECT_EQ(2u, Log2Histogram::GetBucket(2));
+        EXPECT_EQ(2u, Log2Histogram::GetBucket(3));
+        EXPECT_EQ(3u, Log2Histogram::GetBucket(4));
+        EXPECT_EQ(11u, Log2Histogram::GetBucket(1024));
+        EXPECT_EQ(Log2Histogram::NUM_BUCKETS - 1, Log2Histogram::GetBucket(UINT64_MAX));
+
+        EXPECT_EQ(0u, Log2HistogramSnapshot::GetBucketUpperBound(0));
+        EXPECT_EQ(1u, Log2HistogramSnapshot::GetBucketUpperBound(1));
+        EXPECT_EQ(2047u, Log2HistogramSnapshot::GetBucketUpperBound(11));
+    }
+
+    TEST_F(Log2HistogramTests, Record) {
+        Log2Histogram histogram;
+        histogram.Record(0);
+        histogram.Record(5);
+        histogram.Record(6);
+        histogram.Record(1000);
+
+        auto snapshot = histogram.GetSnapshot();
+        EXPECT_EQ(4u, snapshot.GetCount());
+        EXPECT_EQ(1011u, snapshot.GetSum());
+        EXPECT_EQ(1000u, snapshot.GetMax());
+        EXPECT_DOUBLE_EQ(252.75, snapshot.GetMean());
+        EXPECT_EQ(1u, snapshot.GetBucketCount(0));
+        EXPECT_EQ(2u, snapshot.GetBucketCount(3));
+        EXPECT_EQ(1u, snapshot.GetBucketCount(10));
+
+        histogram.Reset();
+        EXPECT_EQ(0u, histogram.GetSnapshot().GetCount());
+    }
+
+    TEST_F(Log2HistogramTests, Percentiles) {
+        Log2Histogram histogram;
+        EXPECT_EQ(0u, histogram.GetSnapshot().GetPercentile(50.0));
+
+        for(uint64_t i = 0; i < 90; i++)
+            histogram.Record(10);
+        for(uint64_t i = 0; i < 10; i++)
+            histogram.Record(1000);
+
+        auto snapshot = histogram.GetSnapshot();
+        EXPECT_EQ(15u, snapshot.GetPercentile(50.0));
+        EXPECT_EQ(15u, snapshot.GetPercentile(90.0));
+        EXPECT_EQ(1000u, snapshot.GetPercentile(91.0));
+        EXPECT_EQ(1000u, snapshot.GetPercentile(100.0));
+        EXPECT_THROW(snapshot.GetPercentile(101.0), std::invalid_argument);
+    }
+
+    TEST_F(Log2HistogramTests, Merge) {
+        Log2Histogram histogram1;
+        Log2Histogram histogram2;
+        histogram1.Record(1);
+        histogram2.Record(100);
+        histogram2.Record(100);
+
+        auto snapshot = histogram1.GetSnapshot();
+        snapshot += histogram2.GetSnapshot();
+        EXPECT_EQ(3u, snapshot.GetCount());
+        EXPECT_EQ(201u, snapshot.GetSum());
+        EXPECT_EQ(100u, snapshot.GetMax());
+    }
+
+    TEST_F(Log2HistogramTests, ManyThreadsRecord) {
+        Log2Histogram histogram;
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&]() {
+                for(uint64_t value = 0; value < 10000; value++)
+                    histogram.Record(value);
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        auto snapshot = histogram.GetSnapshot();
+        EXPECT_EQ(40000u, snapshot.GetCount());
+        EXPECT_EQ(4u * (9999u * 10000u / 2), snapshot.GetSum());
+        EXPECT_EQ(9999u, snapshot.GetMax());
+    }
+
+}  // namespace
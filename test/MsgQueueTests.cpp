@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-24
-/// \last-modified		2017-10-24
+/// \last-modified		2026-10-17
 /// \brief 				Contains tests for the MsgQueue class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -12,13 +12,17 @@
 #include <future>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
 
 // 3rd party includes
 
 #include "gtest/gtest.h"
 
 // User includes
+#include "CppUtils/HeapTracker.hpp"
 #include "CppUtils/MsgQueue.hpp"
 
 using namespace mn::CppUtils::MsgQueue;
@@ -99,4 +103,232 @@ namespace {
         auto returnedData = thread1.GetData();
         EXPECT_EQ("Hello", returnedData);
     }
+
+    TEST_F(MsgQueueTests, MsgIdHashedAtCompileTime) {
+        constexpr MsgId exitId("EXIT");
+        static_assert(exitId == "EXIT"_msgId, "Literal and constexpr MsgIds must match.");
+        // FNV-1a test vector
+        static_assert(MsgId("a").GetValue() == 0xE40C292Cu, "MsgId must be the 32-bit FNV-1a hash.");
+        EXPECT_EQ(exitId, MsgId(std::string("EXIT")));
+        EXPECT_NE(exitId, "EXIT2"_msgId);
+    }
+
+    TEST_F(MsgQueueTests, SwitchOnMsgId) {
+        MsgQueue queue;
+        queue.Push(TxMsg("SET_DATA"_msgId, std::make_shared<int>(5)));
+        queue.Push(TxMsg("EXIT"_msgId));
+
+        int data = 0;
+        RxMsg msg;
+        bool exit = false;
+        while(!exit) {
+            queue.Pop(msg);
+            switch(msg.GetId()) {
+                case "SET_DATA"_msgId:
+                    data = *std::static_pointer_cast<int>(msg.GetData());
+                    break;
+                case "EXIT"_msgId:
+                    exit = true;
+                    break;
+                default:
+                    FAIL() << "Unexpected msg " << msg.GetId().GetName();
+            }
+        }
+        EXPECT_EQ(5, data);
+    }
+
+    TEST_F(MsgQueueTests, MsgIdNames) {
+        auto id = MsgId::Register("REGISTERED_MSG");
+        EXPECT_EQ("REGISTERED_MSG"_msgId, id);
+        EXPECT_EQ("REGISTERED_MSG", id.GetName());
+        // Registering the same name again is fine
+        EXPECT_EQ(id, MsgId::Register("REGISTERED_MSG"));
+
+        EXPECT_EQ("0xE40C292C", MsgId("a").GetName());
+    }
+
+    TEST_F(MsgQueueTests, MsgIdCollisionExceptionTest) {
+        // A known 32-bit FNV-1a collision
+        ASSERT_EQ(MsgId("costarring"), MsgId("liquid"));
+        MsgId::Register("costarring");
+        EXPECT_THROW(MsgId::Register("liquid"), std::invalid_argument);
+    }
+
+    struct Position {
+        double x_;
+        double y_;
+    };
+
+    TEST_F(MsgQueueTests, PayloadTypeChecked) {
+        Payload payload(Position{ 1.0, 2.0 });
+        EXPECT_TRUE(payload.HasValue());
+        EXPECT_TRUE(payload.IsInline());
+        EXPECT_TRUE(payload.Holds<Position>());
+        EXPECT_FALSE(payload.Holds<int>());
+        EXPECT_EQ(2.0, payload.Get<Position>().y_);
+        EXPECT_EQ(nullptr, payload.GetIf<int>());
+        EXPECT_THROW(payload.Get<int>(), std::runtime_error);
+
+        payload.Reset();
+        EXPECT_FALSE(payload.HasValue());
+        EXPECT_THROW(payload.Get<Position>(), std::runtime_error);
+    }
+
+    TEST_F(MsgQueueTests, PayloadLargeValueOnHeap) {
+        std::vector<int> values(100, 5);
+        struct Large {
+            char data_[Payload::CAPACITY + 1];
+        };
+        static_assert(!Payload::IsStoredInline<Large>(), "Large must not fit inline.");
+
+        Payload payload(Large{});
+        EXPECT_FALSE(payload.IsInline());
+
+        // Copies and moves keep the value
+        payload.Emplace<std::vector<int>>(values);
+        Payload copy(payload);
+        Payload moved(std::move(payload));
+        EXPECT_FALSE(payload.HasValue());
+        EXPECT_EQ(values, copy.Get<std::vector<int>>());
+        EXPECT_EQ(values, moved.Get<std::vector<int>>());
+    }
+
+    TEST_F(MsgQueueTests, PayloadNotCopyableExceptionTest) {
+        Payload payload(std::unique_ptr<int>(new int(5)));
+        EXPECT_THROW(Payload copy(payload), std::runtime_error);
+
+        Payload moved(std::move(payload));
+        EXPECT_EQ(5, *moved.Get<std::unique_ptr<int>>());
+    }
+
+    TEST_F(MsgQueueTests, SmallPayloadPushPopDoesNotAllocate) {
+        MsgQueue queue;
+        RxMsg msg;
+
+        // Let the ring buffer grow to it's peak size first
+        for(int i = 0; i < 100; i++)
+            queue.Push(TxMsg("POSITION"_msgId, Position{ 0.0, 0.0 }));
+        for(int i = 0; i < 100; i++)
+            queue.Pop(msg);
+
+        auto numAllocations = mn::CppUtils::HeapTracker::Instance().GetNumAllocations();
+        double sum = 0.0;
+        for(int i = 0; i < 1000; i++) {
+            queue.Push(TxMsg("POSITION"_msgId, Position{ static_cast<double>(i), 0.0 }));
+            if(i % 10 == 9) {
+                for(int j = 0; j < 10; j++) {
+                    queue.Pop(msg);
+                    sum += msg.GetPayload().Get<Position>().x_;
+                }
+            }
+        }
+        EXPECT_EQ(numAllocations, mn::CppUtils::HeapTracker::Instance().GetNumAllocations());
+        EXPECT_EQ(499500.0, sum);
+    }
+
+    TEST_F(MsgQueueTests, QueueKeepsOrderWhileGrowing) {
+        MsgQueue queue;
+        RxMsg msg;
+
+        // Wrap the ring buffer around before it grows
+        for(int i = 0; i < 10; i++) {
+            queue.Push(TxMsg("VALUE"_msgId, i));
+            queue.Pop(msg);
+        }
+        for(int i = 0; i < 100; i++)
+            queue.Push(TxMsg("VALUE"_msgId, i));
+        EXPECT_EQ(100u, queue.Size());
+        for(int i = 0; i < 100; i++) {
+            ASSERT_TRUE(queue.TryPop(msg, std::chrono::milliseconds(0)));
+            EXPECT_EQ(i, msg.GetPayload().Get<int>());
+        }
+        EXPECT_FALSE(queue.TryPop(msg, std::chrono::milliseconds(0)));
+    }
+
+    TEST_F(MsgQueueTests, ReplyPollAndTimeout) {
+        MsgQueue queue;
+        TxMsg request("GET_VALUE"_msgId, ReturnType::RETURN_DATA);
+        queue.Push(request);
+
+        VData data;
+        EXPECT_FALSE(request.TryWaitForData(data, std::chrono::milliseconds(0)));
+        EXPECT_EQ(nullptr, request.TryWaitForReply(std::chrono::milliseconds(10)));
+
+        RxMsg msg;
+        queue.Pop(msg);
+        msg.ReturnPayload(42);
+
+        auto reply = request.TryWaitForReply(std::chrono::milliseconds(0));
+        ASSERT_NE(nullptr, reply);
+        EXPECT_EQ(42, reply->Get<int>());
+        EXPECT_EQ(42, request.WaitForReply().Get<int>());
+
+        // The reply was not VData
+        EXPECT_THROW(request.WaitForData(), std::runtime_error);
+    }
+
+    TEST_F(MsgQueueTests, ReplyAcrossThreads) {
+        MsgQueue queue;
+        const int numRequests = 10000;
+
+        std::thread server([&]() {
+            RxMsg msg;
+            for(int i = 0; i < numRequests; i++) {
+                queue.Pop(msg);
+                msg.ReturnPayload(msg.GetPayload().Get<int>() * 2);
+            }
+        });
+
+        // Warm up the pool, so it only grows if slots are not recycled
+        TxMsg warmUp("DOUBLE"_msgId, 0, ReturnType::RETURN_DATA);
+        queue.Push(warmUp);
+        warmUp.WaitForReply();
+        auto poolSize = ReplyChannel::GetPoolSize();
+
+        for(int i = 1; i < numRequests; i++) {
+            TxMsg request("DOUBLE"_msgId, i, ReturnType::RETURN_DATA);
+            queue.Push(request);
+            ASSERT_EQ(i * 2, request.WaitForReply().Get<int>());
+        }
+        server.join();
+        EXPECT_EQ(poolSize, ReplyChannel::GetPoolSize());
+    }
+
+    TEST_F(MsgQueueTests, ReplyRoundTripDoesNotAllocate) {
+        MsgQueue queue;
+        RxMsg msg;
+
+        auto roundTrip = [&](int value) {
+            TxMsg request("DOUBLE"_msgId, value, ReturnType::RETURN_DATA);
+            queue.Push(std::move(request));
+            queue.Pop(msg);
+            msg.ReturnPayload(msg.GetPayload().Get<int>() * 2);
+        };
+        roundTrip(0);
+
+        auto numAllocations = mn::CppUtils::HeapTracker::Instance().GetNumAllocations();
+        for(int i = 0; i < 1000; i++) {
+            TxMsg request("DOUBLE"_msgId, i, ReturnType::RETURN_DATA);
+            queue.Push(request);
+            queue.Pop(msg);
+            msg.ReturnPayload(msg.GetPayload().Get<int>() * 2);
+            EXPECT_EQ(i * 2, request.WaitForReply().Get<int>());
+        }
+        EXPECT_EQ(numAllocations, mn::CppUtils::HeapTracker::Instance().GetNumAllocations());
+    }
+
+    TEST_F(MsgQueueTests, ReplyExceptionTest) {
+        TxMsg noReturn("NO_RETURN"_msgId);
+        EXPECT_THROW(noReturn.WaitForData(), std::runtime_error);
+
+        MsgQueue queue;
+        TxMsg request("GET_VALUE"_msgId, ReturnType::RETURN_DATA);
+        queue.Push(request);
+        RxMsg msg;
+        queue.Pop(msg);
+        msg.ReturnData(std::make_shared<int>(1));
+        EXPECT_THROW(msg.ReturnData(std::make_shared<int>(2)), std::runtime_error);
+        EXPECT_EQ(1, *std::static_pointer_cast<int>(request.WaitForData()));
+    }
+
 }  // namespace
\ No newline at end of file
@@ -3,13 +3,15 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-09-22
-/// \last-modified		2017-10-11
+/// \last-modified		2026-10-17
 /// \brief 				Contains tests for the Semaphore class.
 /// \details
 ///		See README.md in root dir for more info.
 
 // System includes
+#include <atomic>
 #include <chrono>
+#include <vector>
 
 // 3rd party includes
 #include <thread>
@@ -82,4 +84,85 @@ namespace {
         t1.join();
     }
 
+    TEST_F(SemaphoreTests, NotifyCountWakesManyWaiters) {
+        Semaphore semaphore;
+        constexpr int NUM_THREADS = 4;
+        std::atomic<int> numWoken(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < NUM_THREADS; i++) {
+            threads.push_back(std::thread([&]() {
+                semaphore.Wait();
+                numWoken.fetch_add(1);
+            }));
+        }
+
+        std::this_thread::sleep_for(50ms);
+        EXPECT_EQ(0, numWoken.load());
+        semaphore.Notify(NUM_THREADS);
+
+        for(auto& thread : threads)
+            thread.join();
+        EXPECT_EQ(NUM_THREADS, numWoken.load());
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(SemaphoreTests, WaitCountTakesAllPermitsAtOnce) {
+        Semaphore semaphore;
+        std::atomic<bool> acquired(false);
+
+        std::thread t1([&]() {
+            semaphore.Wait(3);
+            acquired.store(true);
+        });
+
+        semaphore.Notify();
+        semaphore.Notify();
+        std::this_thread::sleep_for(50ms);
+        EXPECT_FALSE(acquired.load());
+
+        semaphore.Notify();
+        t1.join();
+        EXPECT_TRUE(acquired.load());
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(SemaphoreTests, TryWaitCountTimesOutWithoutTakingPermits) {
+        Semaphore semaphore;
+        semaphore.Notify(2);
+
+        EXPECT_FALSE(semaphore.TryWait(3, 50ms));
+
+        // The two permits are still there
+        EXPECT_TRUE(semaphore.TryWait(2, 0ms));
+        EXPECT_FALSE(semaphore.TryWait(0ms));
+    }
+
+    TEST_F(SemaphoreTests, NotifyWakesSingleWaiterBehindMultiWaiter) {
+        Semaphore semaphore;
+        std::atomic<bool> multiAcquired(false);
+        std::atomic<bool> singleAcquired(false);
+
+        std::thread t1([&]() {
+            semaphore.Wait(2);
+            multiAcquired.store(true);
+        });
+        std::this_thread::sleep_for(20ms);
+        std::thread t2([&]() {
+            semaphore.Wait();
+            singleAcquired.store(true);
+        });
+        std::this_thread::sleep_for(20ms);
+
+        // One permit is not enough for the first thread, but must not be lost on it either
+        semaphore.Notify();
+        t2.join();
+        EXPECT_TRUE(singleAcquired.load());
+        EXPECT_FALSE(multiAcquired.load());
+
+        semaphore.Notify(2);
+        t1.join();
+        EXPECT_TRUE(multiAcquired.load());
+    }
+
 }  // namespace
\ No newline at end of file
@@ -0,0 +1,211 @@
+///
+/// \file 				ShardedTimerWheelTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the ShardedTimerWheel class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/ShardedTimerWheel.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils::TimerWheel;
+
+namespace {
+
+    class ShardedTimerWheelTests : public ::testing::Test {
+    protected:
+        ShardedTimerWheelTests() {}
+        virtual ~ShardedTimerWheelTests() {}
+    };
+
+    TEST_F(ShardedTimerWheelTests, SingleTimer) {
+        ShardedTimerWheel timerWheel(4);
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(50ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(ShardedTimerWheelTests, ThreadsUseDifferentShards) {
+        ShardedTimerWheel timerWheel(4);
+
+        std::atomic<int> counter(0);
+        std::vector<ShardedTimerHandle> timerHandles(4);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&, i]() {
+                timerHandles[i] = timerWheel.AddSingleShotTimer(50ms, [&]() {
+                    counter.fetch_add(1);
+                });
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        // Each thread is given it's own shard the first time it adds a timer
+        std::set<uint32_t> shards;
+        for(auto& timerHandle : timerHandles)
+            shards.insert(timerHandle.GetShard());
+        EXPECT_EQ(4, shards.size());
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(4, counter.load());
+    }
+
+    TEST_F(ShardedTimerWheelTests, EachInstanceSpreadsThreadsSeparately) {
+        ShardedTimerWheel first(2);
+        ShardedTimerWheel second(2);
+
+        // Three threads in turn, only the first and last of which use the second wheel. Which threads used the first
+        // wheel must not affect how the second one spreads them
+        std::vector<ShardedTimerHandle> timerHandles;
+        for(int i = 0; i < 3; i++) {
+            std::thread([&, i]() {
+                first.AddSingleShotTimer(1h, []() {});
+                if(i != 1)
+                    timerHandles.push_back(second.AddSingleShotTimer(1h, []() {}));
+            }).join();
+        }
+
+        ASSERT_EQ(2u, timerHandles.size());
+        EXPECT_NE(timerHandles[0].GetShard(), timerHandles[1].GetShard());
+    }
+
+    TEST_F(ShardedTimerWheelTests, RemoveFromOtherThread) {
+        ShardedTimerWheel timerWheel(4);
+
+        std::atomic<int> counter(0);
+
+        ShardedTimerHandle timerHandle;
+        std::thread thread([&]() {
+            timerHandle = timerWheel.AddSingleShotTimer(100ms, [&]() {
+                counter.fetch_add(1);
+            });
+        });
+        thread.join();
+
+        EXPECT_TRUE(timerWheel.RemoveTimer(timerHandle));
+        EXPECT_FALSE(timerWheel.RemoveTimer(timerHandle));
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(0, counter.load());
+    }
+
+    TEST_F(ShardedTimerWheelTests, ManyThreadsManyTimers) {
+        ShardedTimerWheel timerWheel(4);
+
+        std::atomic<int> counter(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 8; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < 1000; j++) {
+                    timerWheel.AddSingleShotTimer(std::chrono::milliseconds(j % 100), [&]() {
+                        counter.fetch_add(1);
+                    });
+                }
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        std::this_thread::sleep_for(300ms);
+        EXPECT_EQ(8000, counter.load());
+    }
+
+    TEST_F(ShardedTimerWheelTests, BatchAddAndRemove) {
+        ShardedTimerWheel timerWheel(4);
+
+        std::atomic<int> counter(0);
+
+        std::vector<TimerSpec> timerSpecs;
+        for(int i = 0; i < 100; i++) {
+            timerSpecs.push_back(TimerSpec::SingleShot(50ms, [&]() {
+                counter.fetch_add(1);
+            }));
+        }
+
+        std::vector<ShardedTimerHandle> timerHandles;
+        timerWheel.AddTimers(timerSpecs.begin(), timerSpecs.end(), std::back_inserter(timerHandles));
+        EXPECT_EQ(100, timerHandles.size());
+
+        EXPECT_EQ(30, timerWheel.RemoveTimers(timerHandles.begin(), timerHandles.begin() + 30));
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(70, counter.load());
+    }
+
+    TEST_F(ShardedTimerWheelTests, RestartFromOtherThread) {
+        ShardedTimerWheel timerWheel(2);
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(100ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        std::thread otherThread([&]() {
+            std::this_thread::sleep_for(50ms);
+            EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 100ms));
+        });
+        otherThread.join();
+
+        std::this_thread::sleep_for(70ms);
+        EXPECT_EQ(0, counter.load());
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(ShardedTimerWheelTests, StatsCombineShards) {
+        ShardedTimerWheel timerWheel(2);
+
+        std::atomic<int> counter(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 2; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < 5; j++) {
+                    timerWheel.AddSingleShotTimer(10ms, [&]() {
+                        counter.fetch_add(1);
+                    });
+                }
+                timerWheel.AddSingleShotTimer(10s, [&]() {});
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(10, counter.load());
+
+        auto stats = timerWheel.GetStats();
+        EXPECT_EQ(10u, stats.GetLateness().GetCount());
+        EXPECT_EQ(2u, stats.GetNumTimers());
+    }
+
+    TEST_F(ShardedTimerWheelTests, ZeroShardsExceptionTest) {
+        EXPECT_THROW(ShardedTimerWheel(0), std::invalid_argument);
+    }
+
+}  // namespace
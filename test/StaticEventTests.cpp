@@ -0,0 +1,110 @@
+///
+/// \file 				StaticEventTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the StaticEvent class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <string>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/HeapTracker.hpp"
+#include "CppUtils/StaticEvent.hpp"
+
+using namespace mn::CppUtils;
+
+namespace {
+
+    class StaticEventTests : public ::testing::Test {
+    protected:
+        StaticEventTests() {}
+        virtual ~StaticEventTests() {}
+    };
+
+    struct CountingListener {
+        int numCalls_ = 0;
+
+        void operator()() {
+            numCalls_++;
+        }
+    };
+
+    TEST_F(StaticEventTests, TypeList) {
+        StaticEvent<CountingListener, CountingListener> event;
+        static_assert(decltype(event)::GetNumListeners() == 2, "GetNumListeners() must be constexpr.");
+
+        event.Fire();
+        event.Fire();
+        EXPECT_EQ(2, event.GetListener<0>().numCalls_);
+        EXPECT_EQ(2, event.GetListener<1>().numCalls_);
+    }
+
+    TEST_F(StaticEventTests, ListenersCalledInOrder) {
+        std::vector<int> calls;
+        auto event = MakeStaticEvent(
+                [&](int value) { calls.push_back(value); },
+                [&](int value) { calls.push_back(value * 10); },
+                [&](int value) { calls.push_back(value * 100); });
+
+        event.Fire(2);
+        ASSERT_EQ(3u, calls.size());
+        EXPECT_EQ(2, calls[0]);
+        EXPECT_EQ(20, calls[1]);
+        EXPECT_EQ(200, calls[2]);
+    }
+
+    TEST_F(StaticEventTests, EveryListenerGetsSameParameters) {
+        std::vector<std::string> received;
+        auto event = MakeStaticEvent(
+                [&](std::string msg) { received.push_back(std::move(msg)); },
+                [&](std::string msg) { received.push_back(std::move(msg)); });
+
+        event.Fire(std::string("a string long enough to not fit in the small string buffer"));
+        ASSERT_EQ(2u, received.size());
+        EXPECT_EQ(received[0], received[1]);
+    }
+
+    TEST_F(StaticEventTests, RvalueReferenceListeners) {
+        std::vector<std::string> received;
+        auto event = MakeStaticEvent(
+                [&](std::string&& msg) { received.push_back(std::move(msg)); },
+                [&](const std::string& msg) { received.push_back(msg); },
+                [&](std::string&& msg) { received.push_back(std::move(msg)); });
+
+        event.Fire(std::string("Hello"));
+        std::string msg("World");
+        event.Fire(msg);
+        EXPECT_EQ(std::vector<std::string>({ "Hello", "Hello", "Hello", "World", "World", "World" }), received);
+        EXPECT_EQ("World", msg);
+    }
+
+    TEST_F(StaticEventTests, NoListeners) {
+        StaticEvent<> event;
+        event.Fire(1, "unused");
+        EXPECT_EQ(0u, event.GetNumListeners());
+    }
+
+    TEST_F(StaticEventTests, FireDoesNotAllocate) {
+        int sum = 0;
+        auto event = MakeStaticEvent(
+                [&](const std::vector<int>& values) { sum += values[0]; },
+                [&](const std::vector<int>& values) { sum += values[1]; });
+        std::vector<int> values = { 1, 2 };
+
+        auto numAllocations = HeapTracker::Instance().GetNumAllocations();
+        for(int i = 0; i < 100; i++)
+            event.Fire(values);
+
+        EXPECT_EQ(numAllocations, HeapTracker::Instance().GetNumAllocations());
+        EXPECT_EQ(300, sum);
+    }
+
+}  // namespace
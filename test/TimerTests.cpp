@@ -3,7 +3,7 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-06
-/// \last-modified		2017-10-06
+/// \last-modified		2026-10-17
 /// \brief 				Contains tests for the Timer class.
 /// \details
 ///		See README.md in root dir for more info.
@@ -11,7 +11,9 @@
 // System includes
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <thread>
+#include <vector>
 
 // 3rd party includes
 #include "gtest/gtest.h"
@@ -55,4 +57,56 @@ namespace {
         EXPECT_FALSE(callbackCalled.load());
     }
 
+    TEST_F(TimerTests, DestroyWaitsForRunningCallback) {
+        std::atomic<bool> callbackStarted(false);
+        std::atomic<bool> callbackFinished(false);
+
+        {
+            Timer timer(10ms, [&] {
+                callbackStarted.store(true);
+                std::this_thread::sleep_for(100ms);
+                callbackFinished.store(true);
+            });
+
+            while(!callbackStarted.load())
+                std::this_thread::yield();
+        } // Timer gets destroyed here while the callback is running, which must wait for it to return
+
+        EXPECT_TRUE(callbackFinished.load());
+    }
+
+    TEST_F(TimerTests, ManyTimers) {
+        // Every Timer is a handle on a shared timer thread, so lots of them at once is cheap
+        constexpr int NUM_TIMERS = 10000;
+        std::atomic<int> counter(0);
+
+        std::vector<std::unique_ptr<Timer>> timers;
+        for(int i = 0; i < NUM_TIMERS; i++) {
+            timers.push_back(std::unique_ptr<Timer>(new Timer(std::chrono::milliseconds(50 + i % 50), [&] {
+                counter.fetch_add(1);
+            })));
+        }
+
+        // Destroy every second Timer before it expires
+        for(int i = 0; i < NUM_TIMERS; i += 2)
+            timers[i].reset();
+
+        std::this_thread::sleep_for(300ms);
+        EXPECT_EQ(NUM_TIMERS / 2, counter.load());
+    }
+
+    /// \brief      Constructed before main(), so destroyed during program exit after anything created on first use
+    ///             by the tests.
+    std::unique_ptr<Timer> staticTimer;
+
+    TEST_F(TimerTests, DestroyDuringProgramExit) {
+        // The Timer is destroyed after the tests have finished, when the global above is. This must not touch a
+        // destroyed TimerWheel (run under ASan to check)
+        staticTimer.reset(new Timer(1h, [] {}));
+    }
+
+    TEST_F(TimerTests, NegativeDurationExceptionTest) {
+        EXPECT_THROW(Timer(-1ms, [] {}), std::invalid_argument);
+    }
+
 }  // namespace
\ No newline at end of file
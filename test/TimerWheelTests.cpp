@@ -3,20 +3,25 @@
 /// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
 /// \edited             n/a
 /// \created			2017-10-16
-/// \last-modified		2017-10-17
+/// \last-modified		2026-10-17
 /// \brief 				Contains tests for the TimerWheel class.
 /// \details
 ///		See README.md in root dir for more info.
 
 // System includes
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <functional>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 // 3rd party includes
 #include "gtest/gtest.h"
 
 // User includes
+#include "CppUtils/HeapTracker.hpp"
 #include "CppUtils/TimerWheel.hpp"
 
 using namespace std::literals;
@@ -221,13 +226,884 @@ namespace {
             counter.fetch_add(1);
         });
 
-        // Since the timer ID is the same as the pointer to the timer, we can safely
-        // assume an ID of 0 is never possible
-        EXPECT_FALSE(timerWheel.RemoveTimer(0));
+        // A default constructed handle never refers to a timer
+        EXPECT_FALSE(timerWheel.RemoveTimer(TimerHandle()));
 
         std::this_thread::sleep_for(100ms);
 
         EXPECT_EQ(1, counter.load());
     }
 
+    TEST_F(TimerWheelTests, RemoveTwice) {
+        TimerWheel timerWheel;
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(500ms, [&]() {});
+
+        EXPECT_TRUE(timerWheel.RemoveTimer(timerHandle));
+        EXPECT_FALSE(timerWheel.RemoveTimer(timerHandle));
+    }
+
+    TEST_F(TimerWheelTests, StaleHandleDoesNotRemoveNewTimer) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle1 = timerWheel.AddSingleShotTimer(500ms, [&]() {});
+        EXPECT_TRUE(timerWheel.RemoveTimer(timerHandle1));
+
+        // The second timer will re-use the same entry as the first, but the old handle must not be
+        // able to remove it
+        auto timerHandle2 = timerWheel.AddSingleShotTimer(50ms, [&]() {
+            counter.fetch_add(1);
+        });
+        EXPECT_NE(timerHandle1, timerHandle2);
+        EXPECT_FALSE(timerWheel.RemoveTimer(timerHandle1));
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, ManyTimers) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        for(int i = 0; i < 10000; i++) {
+            timerWheel.AddSingleShotTimer(std::chrono::milliseconds(i % 300), [&]() {
+                counter.fetch_add(1);
+            });
+        }
+
+        std::this_thread::sleep_for(500ms);
+        EXPECT_EQ(10000, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, TimerBeyondWheelSpan) {
+        // A single level wheel with a 1ms tick only spans 256ms, so a 400ms timer has to go
+        // around the wheel more than once
+        TimerWheel timerWheel(1ms, 1);
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(400ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        std::this_thread::sleep_for(300ms);
+        EXPECT_EQ(0, counter.load());
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, TimerCascadesDownLevels) {
+        // With a 1ms tick, a 700ms timer starts in level 1 and has to be cascaded down into level 0
+        TimerWheel timerWheel(1ms, 2);
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(700ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        std::this_thread::sleep_for(600ms);
+        EXPECT_EQ(0, counter.load());
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, IdleLongTimerDoesNotWakeOnEveryWrap) {
+        // With a 100us tick, level 0 wraps every 25.6ms, but nothing needs cascading until the 1 hour timer gets
+        // close, so the timer wheel thread should stay asleep
+        TimerWheel timerWheel(100us);
+        timerWheel.AddSingleShotTimer(1h, [&]() {});
+
+        std::this_thread::sleep_for(10ms);
+        auto stats = timerWheel.GetStats();
+        EXPECT_EQ(1u, stats.GetNumTimers());
+
+        std::this_thread::sleep_for(300ms);
+        auto laterStats = timerWheel.GetStats();
+        EXPECT_LE(laterStats.GetNumWakeups() - stats.GetNumWakeups(), 1u);
+    }
+
+    TEST_F(TimerWheelTests, CallbackCanAddAndRemoveTimers) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(200ms, [&]() {
+            counter.fetch_add(10);
+        });
+
+        // Callbacks are called without the wheel being locked, so they can add and remove timers
+        timerWheel.AddSingleShotTimer(50ms, [&]() {
+            timerWheel.RemoveTimer(timerHandle);
+            timerWheel.AddSingleShotTimer(50ms, [&]() {
+                counter.fetch_add(1);
+            });
+        });
+
+        std::this_thread::sleep_for(300ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    class RecordingExecutor : public mn::CppUtils::Executor {
+    public:
+        void Execute(std::function<void()> task) override {
+            numTasks_.fetch_add(1);
+            task();
+        }
+
+        std::atomic<int> numTasks_{0};
+    };
+
+    TEST_F(TimerWheelTests, CallbacksGivenToExecutor) {
+        auto executor = std::make_shared<RecordingExecutor>();
+        TimerWheel timerWheel(1ms, 4, executor);
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(50ms, [&]() {
+            counter.fetch_add(1);
+        });
+        timerWheel.AddRepetitiveTimer(100ms, -1, [&]() {
+            counter.fetch_add(1);
+        });
+
+        std::this_thread::sleep_for(250ms);
+        EXPECT_EQ(3, counter.load());
+        EXPECT_EQ(3, executor->numTasks_.load());
+    }
+
+    TEST_F(TimerWheelTests, SlowCallbackDoesNotDelayOtherTimers) {
+        TimerWheel timerWheel(1ms, 4, std::make_shared<mn::CppUtils::ThreadPoolExecutor>(2));
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(50ms, [&]() {
+            std::this_thread::sleep_for(500ms);
+        });
+        timerWheel.AddSingleShotTimer(100ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, MicrosecondTimers) {
+        TimerWheel timerWheel(10us);
+
+        std::atomic<int> counter(0);
+        std::atomic<int64_t> maxLateness_us(0);
+
+        for(int i = 0; i < 10; i++) {
+            auto duration = std::chrono::microseconds(500 + i * 250);
+            auto deadline = std::chrono::steady_clock::now() + duration;
+            timerWheel.AddSingleShotTimer(duration, [&, deadline]() {
+                auto lateness_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - deadline).count();
+                // Timers must never expire early
+                EXPECT_GE(lateness_us, 0);
+                if(lateness_us > maxLateness_us.load())
+                    maxLateness_us.store(lateness_us);
+                counter.fetch_add(1);
+            });
+        }
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(10, counter.load());
+
+        // Sub-millisecond timers should not be rounded up to the next millisecond. The bound is loose
+        // so the test is not flaky on a loaded machine
+        EXPECT_LT(maxLateness_us.load(), 5000);
+    }
+
+    TEST_F(TimerWheelTests, SlackCoalescesTimers) {
+        TimerWheel timerWheel(100us);
+
+        std::atomic<int> counter(0);
+        std::atomic<int> numOutsideWindow(0);
+
+        // 100 timers with deadlines 100us apart, each with 10ms of slack
+        for(int i = 1; i <= 100; i++) {
+            auto duration = std::chrono::microseconds(i * 100);
+            auto deadline = std::chrono::steady_clock::now() + duration;
+            timerWheel.AddSingleShotTimer(duration, [&, deadline]() {
+                auto now = std::chrono::steady_clock::now();
+                if(now < deadline || now > deadline + 10ms + 5ms)
+                    numOutsideWindow.fetch_add(1);
+                counter.fetch_add(1);
+            }, 10ms);
+        }
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(100, counter.load());
+        EXPECT_EQ(0, numOutsideWindow.load());
+
+        // The timers should of been grouped into a handful of wakeups
+        EXPECT_GE(timerWheel.GetNumWakeupsSaved(), 90);
+    }
+
+    TEST_F(TimerWheelTests, NoSlackNoWakeupsSaved) {
+        TimerWheel timerWheel(100us);
+
+        for(int i = 1; i <= 10; i++)
+            timerWheel.AddSingleShotTimer(std::chrono::microseconds(i * 1000), [&]() {});
+
+        std::this_thread::sleep_for(50ms);
+        EXPECT_EQ(0, timerWheel.GetNumWakeupsSaved());
+    }
+
+    TEST_F(TimerWheelTests, NoAllocationsInSteadyState) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+        std::array<TimerHandle, 100> timerHandles;
+
+        auto runCycle = [&]() {
+            for(std::size_t i = 0; i < timerHandles.size(); i++) {
+                timerHandles[i] = timerWheel.AddSingleShotTimer(10ms, [&]() {
+                    counter.fetch_add(1);
+                });
+            }
+            auto repetitiveTimerHandle = timerWheel.AddRepetitiveTimer(20ms, -1, [&]() {
+                counter.fetch_add(1);
+            });
+
+            // Remove every second single-shot timer before it expires
+            for(std::size_t i = 0; i < timerHandles.size(); i += 2)
+                EXPECT_TRUE(timerWheel.RemoveTimer(timerHandles[i]));
+
+            std::this_thread::sleep_for(50ms);
+            EXPECT_TRUE(timerWheel.RemoveTimer(repetitiveTimerHandle));
+        };
+
+        // The first cycle grows the pool and the wheel's internal buffers
+        runCycle();
+        EXPECT_EQ(52, counter.load());
+
+        auto numAllocations = mn::CppUtils::HeapTracker::Instance().GetNumAllocations();
+        runCycle();
+        runCycle();
+        EXPECT_EQ(numAllocations, mn::CppUtils::HeapTracker::Instance().GetNumAllocations());
+        EXPECT_EQ(156, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, AddTimersBatch) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        std::vector<TimerSpec> timerSpecs;
+        for(int i = 0; i < 100; i++) {
+            timerSpecs.push_back(TimerSpec::SingleShot(std::chrono::milliseconds(10 + i % 50), [&]() {
+                counter.fetch_add(1);
+            }));
+        }
+        timerSpecs.push_back(TimerSpec::Repetitive(40ms, -1, [&]() {
+            counter.fetch_add(1000);
+        }));
+
+        std::vector<TimerHandle> timerHandles;
+        timerWheel.AddTimers(timerSpecs.begin(), timerSpecs.end(), std::back_inserter(timerHandles));
+        EXPECT_EQ(101, timerHandles.size());
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(2100, counter.load());
+        EXPECT_TRUE(timerWheel.RemoveTimer(timerHandles.back()));
+    }
+
+    TEST_F(TimerWheelTests, RemoveTimersBatch) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        std::vector<TimerHandle> timerHandles;
+        for(int i = 0; i < 100; i++) {
+            timerHandles.push_back(timerWheel.AddSingleShotTimer(50ms, [&]() {
+                counter.fetch_add(1);
+            }));
+        }
+
+        // Remove the first 60, one of them twice and a bogus handle as well
+        std::vector<TimerHandle> toRemove(timerHandles.begin(), timerHandles.begin() + 60);
+        toRemove.push_back(timerHandles[0]);
+        toRemove.push_back(TimerHandle());
+        EXPECT_EQ(60, timerWheel.RemoveTimers(toRemove.begin(), toRemove.end()));
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(40, counter.load());
+        EXPECT_EQ(0, timerWheel.RemoveTimers(timerHandles.begin(), timerHandles.end()));
+    }
+
+    TEST_F(TimerWheelTests, AddTimersInvalidSpecAddsNothing) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        std::vector<TimerSpec> timerSpecs;
+        timerSpecs.push_back(TimerSpec::SingleShot(10ms, [&]() {
+            counter.fetch_add(1);
+        }));
+        timerSpecs.push_back(TimerSpec::SingleShot(-10ms, [&]() {
+            counter.fetch_add(1);
+        }));
+
+        std::vector<TimerHandle> timerHandles;
+        EXPECT_THROW(timerWheel.AddTimers(timerSpecs.begin(), timerSpecs.end(), std::back_inserter(timerHandles)),
+                     std::invalid_argument);
+        EXPECT_TRUE(timerHandles.empty());
+
+        std::this_thread::sleep_for(50ms);
+        EXPECT_EQ(0, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, AddDoesNotBlockDuringSlowCallback) {
+        TimerWheel timerWheel;
+
+        std::atomic<bool> callbackRunning(false);
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(10ms, [&]() {
+            callbackRunning.store(true);
+            std::this_thread::sleep_for(300ms);
+        });
+
+        while(!callbackRunning.load())
+            std::this_thread::sleep_for(1ms);
+
+        // The timer wheel thread is busy in the callback, but adding and removing timers must not wait for it
+        auto startTime = std::chrono::steady_clock::now();
+        for(int i = 0; i < 100; i++) {
+            auto timerHandle = timerWheel.AddSingleShotTimer(10ms, [&]() {
+                counter.fetch_add(1);
+            });
+            if(i % 2 == 0) {
+                EXPECT_TRUE(timerWheel.RemoveTimer(timerHandle));
+            }
+        }
+        EXPECT_LT(std::chrono::steady_clock::now() - startTime, 100ms);
+
+        std::this_thread::sleep_for(400ms);
+        EXPECT_EQ(50, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, ManyThreadsAddAndRemove) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+        std::atomic<int> numRemoved(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < 2000; j++) {
+                    auto timerHandle = timerWheel.AddSingleShotTimer(std::chrono::milliseconds(j % 20), [&]() {
+                        counter.fetch_add(1);
+                    });
+
+                    // Races with the timer expiring, either way the timer must fire or be removed, not both
+                    if(j % 3 == 0 && timerWheel.RemoveTimer(timerHandle))
+                        numRemoved.fetch_add(1);
+                }
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(8000, counter.load() + numRemoved.load());
+    }
+
+    TEST_F(TimerWheelTests, RestartPushesBackTimer) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(100ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        // Keep pushing the timer back, like a watchdog, it must not expire while it is being restarted
+        for(int i = 0; i < 10; i++) {
+            std::this_thread::sleep_for(50ms);
+            EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 100ms));
+        }
+        EXPECT_EQ(0, counter.load());
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+
+        // Handle is no longer valid once the timer has expired
+        EXPECT_FALSE(timerWheel.RestartTimer(timerHandle, 100ms));
+        EXPECT_FALSE(timerWheel.RemoveTimer(timerHandle));
+    }
+
+    TEST_F(TimerWheelTests, RestartBringsTimerForward) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(10s, [&]() {
+            counter.fetch_add(1);
+        });
+
+        // The timer wheel thread is asleep until the old expiry, so must be woken up
+        EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 50ms));
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, RestartRepetitiveTimerChangesPeriod) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddRepetitiveTimer(10s, -1, [&]() {
+            counter.fetch_add(1);
+        });
+
+        EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 100ms));
+        std::this_thread::sleep_for(350ms);
+        EXPECT_EQ(3, counter.load());
+        EXPECT_TRUE(timerWheel.RemoveTimer(timerHandle));
+    }
+
+    TEST_F(TimerWheelTests, RestartAfterRemove) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(50ms, [&]() {
+            counter.fetch_add(1);
+        });
+        EXPECT_TRUE(timerWheel.RemoveTimer(timerHandle));
+        EXPECT_FALSE(timerWheel.RestartTimer(timerHandle, 50ms));
+        EXPECT_FALSE(timerWheel.RestartTimer(TimerHandle(), 50ms));
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(0, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, RestartDoesNotAllocate) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(100ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        auto numAllocations = mn::CppUtils::HeapTracker::Instance().GetNumAllocations();
+        for(int i = 0; i < 1000; i++)
+            EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 100ms));
+        EXPECT_EQ(numAllocations, mn::CppUtils::HeapTracker::Instance().GetNumAllocations());
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, ManyThreadsRestartAndRemove) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+        std::atomic<int> numRemoved(0);
+
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&]() {
+                for(int j = 0; j < 2000; j++) {
+                    auto timerHandle = timerWheel.AddSingleShotTimer(std::chrono::milliseconds(j % 5), [&]() {
+                        counter.fetch_add(1);
+                    });
+
+                    // Races with the timer expiring, either way the timer must fire or be removed (exactly once)
+                    timerWheel.RestartTimer(timerHandle, std::chrono::milliseconds(j % 7));
+                    timerWheel.RestartTimer(timerHandle, std::chrono::milliseconds(j % 3));
+                    if(j % 2 == 0 && timerWheel.RemoveTimer(timerHandle))
+                        numRemoved.fetch_add(1);
+                }
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(8000, counter.load() + numRemoved.load());
+    }
+
+    TEST_F(TimerWheelTests, ManyThreadsRestartSameTimer) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+        auto timerHandle = timerWheel.AddSingleShotTimer(1s, [&]() {
+            counter.fetch_add(1);
+        });
+
+        // Competing restarts are all applied, and all report the timer as restarted
+        std::atomic<int> numFailed(0);
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&, i]() {
+                for(int j = 0; j < 10000; j++) {
+                    if(!timerWheel.RestartTimer(timerHandle, std::chrono::milliseconds(500 + i)))
+                        numFailed.fetch_add(1);
+                }
+            }));
+        }
+        for(auto& thread : threads)
+            thread.join();
+        EXPECT_EQ(0, numFailed.load());
+
+        EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 20ms));
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, ConcurrentKeepAlivesNeverBringTimerForward) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+        auto timerHandle = timerWheel.AddSingleShotTimer(50ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        // Every restart pushes the timer out to 50ms from when it was made, so while they keep coming the timer
+        // must never fire, whichever thread's restart is applied last
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> threads;
+        for(int i = 0; i < 4; i++) {
+            threads.push_back(std::thread([&]() {
+                while(!stop)
+                    EXPECT_TRUE(timerWheel.RestartTimer(timerHandle, 50ms));
+            }));
+        }
+        std::this_thread::sleep_for(200ms);
+        stop = true;
+        for(auto& thread : threads)
+            thread.join();
+        EXPECT_EQ(0, counter.load());
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(1, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, NegativeRestartDurationExceptionTest) {
+        TimerWheel timerWheel;
+
+        auto timerHandle = timerWheel.AddSingleShotTimer(100ms, [&]() {});
+        EXPECT_THROW(timerWheel.RestartTimer(timerHandle, -1ms), std::invalid_argument);
+    }
+
+    TEST_F(TimerWheelTests, Stats) {
+        TimerWheel timerWheel;
+
+        std::atomic<int> counter(0);
+
+        // Added as one batch, as timers expiring no earlier than the next wakeup of the timer wheel thread are
+        // only linked into the wheel (and counted) when it wakes up
+        std::vector<TimerSpec> timerSpecs;
+        for(int i = 0; i < 10; i++) {
+            timerSpecs.push_back(TimerSpec::SingleShot(20ms, [&]() {
+                std::this_thread::sleep_for(1ms);
+                counter.fetch_add(1);
+            }));
+        }
+        timerSpecs.push_back(TimerSpec::SingleShot(10s, [&]() {}));
+        std::vector<TimerHandle> timerHandles;
+        timerWheel.AddTimers(timerSpecs.begin(), timerSpecs.end(), std::back_inserter(timerHandles));
+
+        std::this_thread::sleep_for(5ms);
+        auto stats = timerWheel.GetStats();
+        EXPECT_EQ(11u, stats.GetNumTimers());
+        EXPECT_EQ(4u, stats.GetNumTimersInLevel().size());
+        EXPECT_EQ(10u, stats.GetNumTimersInLevel()[0]);
+        EXPECT_EQ(1u, stats.GetNumTimersInLevel()[1]);
+        EXPECT_EQ(0u, stats.GetLateness().GetCount());
+
+        std::this_thread::sleep_for(200ms);
+        EXPECT_EQ(10, counter.load());
+
+        auto laterStats = timerWheel.GetStats();
+        EXPECT_EQ(1u, laterStats.GetNumTimers());
+        EXPECT_EQ(10u, laterStats.GetLateness().GetCount());
+        EXPECT_EQ(10u, laterStats.GetCallbackDuration().GetCount());
+
+        // Callbacks run one after the other, so each one is at least as late as the ones before it took to run
+        EXPECT_GE(laterStats.GetCallbackDuration().GetMax(), 1000000u);
+        EXPECT_GE(laterStats.GetLateness().GetMax(), 9000000u);
+
+        EXPECT_GT(laterStats.GetNumWakeups(), stats.GetNumWakeups());
+        EXPECT_GT(laterStats.GetWakeupsPerSecond(stats), 0.0);
+        EXPECT_GT(laterStats.GetTime(), stats.GetTime());
+    }
+
+    TEST_F(TimerWheelTests, StatsWithExecutor) {
+        TimerWheel timerWheel(1ms, 4, std::make_shared<mn::CppUtils::ThreadPoolExecutor>(2));
+
+        std::atomic<int> counter(0);
+
+        for(int i = 0; i < 10; i++) {
+            timerWheel.AddSingleShotTimer(10ms, [&]() {
+                counter.fetch_add(1);
+            });
+        }
+
+        std::this_thread::sleep_for(100ms);
+        EXPECT_EQ(10, counter.load());
+
+        auto stats = timerWheel.GetStats();
+        EXPECT_EQ(10u, stats.GetLateness().GetCount());
+        EXPECT_EQ(10u, stats.GetCallbackDuration().GetCount());
+        EXPECT_EQ(0u, stats.GetNumTimers());
+    }
+
+    TEST_F(TimerWheelTests, ManualClockSingleTimer) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddSingleShotTimer(500ms, [&]() {
+            counter.fetch_add(1);
+        });
+
+        timerWheel.AdvanceTo(clock->Now() + 499ms);
+        EXPECT_EQ(0, counter.load());
+        timerWheel.AdvanceTo(clock->Now() + 1ms);
+        EXPECT_EQ(1, counter.load());
+        EXPECT_EQ(std::chrono::steady_clock::time_point(500ms), clock->Now());
+    }
+
+    TEST_F(TimerWheelTests, ManualClockDeterministicOrder) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+
+        std::vector<int> order;
+        std::vector<std::chrono::steady_clock::time_point> times;
+
+        // Added out of deadline order, 2 and 3 have the same deadline, and 4 and 5 expire on the same tick
+        timerWheel.AddSingleShotTimer(300ms, [&]() { order.push_back(1); times.push_back(clock->Now()); });
+        timerWheel.AddSingleShotTimer(100ms, [&]() { order.push_back(2); times.push_back(clock->Now()); });
+        timerWheel.AddSingleShotTimer(100ms, [&]() { order.push_back(3); times.push_back(clock->Now()); });
+        timerWheel.AddSingleShotTimer(200400us, [&]() { order.push_back(5); times.push_back(clock->Now()); });
+        timerWheel.AddSingleShotTimer(200200us, [&]() { order.push_back(4); times.push_back(clock->Now()); });
+
+        timerWheel.AdvanceTo(clock->Now() + 10s);
+        EXPECT_EQ(std::vector<int>({ 2, 3, 4, 5, 1 }), order);
+
+        // Callbacks see the time of the tick the timer expired on
+        using TimePoint = std::chrono::steady_clock::time_point;
+        EXPECT_EQ(std::vector<TimePoint>({ TimePoint(100ms), TimePoint(100ms), TimePoint(201ms), TimePoint(201ms),
+                                           TimePoint(300ms) }), times);
+    }
+
+    TEST_F(TimerWheelTests, ManualClockTimersAddedByCallbacks) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+
+        // Each callback adds the next timer in the chain, all those due before the time advanced to are called
+        std::vector<std::chrono::steady_clock::time_point> times;
+        std::function<void()> onExpiry = [&]() {
+            times.push_back(clock->Now());
+            timerWheel.AddSingleShotTimer(100ms, onExpiry);
+        };
+        timerWheel.AddSingleShotTimer(100ms, onExpiry);
+
+        timerWheel.AdvanceTo(clock->Now() + 1050ms);
+        ASSERT_EQ(10u, times.size());
+        EXPECT_EQ(std::chrono::steady_clock::time_point(1000ms), times.back());
+    }
+
+    TEST_F(TimerWheelTests, ManualClockRepetitiveTimer) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+
+        std::atomic<int> counter(0);
+
+        timerWheel.AddRepetitiveTimer(100ms, -1, [&]() {
+            counter.fetch_add(1);
+        });
+
+        timerWheel.AdvanceTo(clock->Now() + 1h);
+        EXPECT_EQ(36000, counter.load());
+    }
+
+    TEST_F(TimerWheelTests, ManualClockManyTimers) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+
+        // Simulate a day with timers spread across it, with no sleeping this only takes a moment
+        constexpr int NUM_TIMERS = 100000;
+        int counter = 0;
+        auto lastTime = clock->Now();
+        bool inOrder = true;
+        for(int i = 0; i < NUM_TIMERS; i++) {
+            auto duration = std::chrono::milliseconds((i * 7919ll) % (24 * 3600 * 1000ll));
+            timerWheel.AddSingleShotTimer(duration, [&]() {
+                inOrder = inOrder && clock->Now() >= lastTime;
+                lastTime = clock->Now();
+                counter++;
+            });
+        }
+
+        timerWheel.AdvanceTo(clock->Now() + 24h);
+        EXPECT_EQ(NUM_TIMERS, counter);
+        EXPECT_TRUE(inOrder);
+        EXPECT_EQ(0u, timerWheel.GetStats().GetNumTimers());
+    }
+
+    TEST_F(TimerWheelTests, ManualClockSparseTimersFireOnTime) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+        auto startTime = clock->Now();
+
+        // Spread across the words of each level's occupancy bitmap, and across the levels
+        std::vector<std::chrono::milliseconds> durations = { 1ms, 63ms, 64ms, 65ms, 200ms, 255ms, 256ms, 257ms, 1000ms,
+                                                             70000ms, 20000000ms };
+        std::vector<std::chrono::milliseconds> firedAt;
+        for(auto duration : durations) {
+            timerWheel.AddSingleShotTimer(duration, [&]() {
+                firedAt.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(clock->Now() - startTime));
+            });
+
+            // Removed timers must not leave their slots marked as occupied
+            auto removedHandle = timerWheel.AddSingleShotTimer(duration + 1ms, [&]() {
+                firedAt.push_back(0ms);
+            });
+            timerWheel.RemoveTimer(removedHandle);
+        }
+
+        timerWheel.AdvanceTo(startTime + 6h);
+        EXPECT_EQ(durations, firedAt);
+    }
+
+    TEST_F(TimerWheelTests, ManualClockExceptionTest) {
+        TimerWheel realTimerWheel;
+        EXPECT_THROW(realTimerWheel.AdvanceTo(std::chrono::steady_clock::now()), std::logic_error);
+
+        auto clock = std::make_shared<ManualClock>(std::chrono::steady_clock::time_point(1s));
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+        EXPECT_THROW(timerWheel.AdvanceTo(std::chrono::steady_clock::time_point(999ms)), std::invalid_argument);
+    }
+
+    TEST_F(TimerWheelTests, FiniteRepetitiveTimerFinishes) {
+        auto clock = std::make_shared<ManualClock>();
+        TimerWheel timerWheel(1ms, 4, nullptr, clock);
+
+        int counter = 0;
+        auto timerHandle = timerWheel.AddRepetitiveTimer(100ms, 3, [&]() {
+            counter++;
+        });
+
+        timerWheel.AdvanceTo(clock->Now() + 1s);
+        EXPECT_EQ(3, counter);
+
+        // The timer has finished, so there is nothing left to remove
+        EXPECT_FALSE(timerWheel.RemoveTimer(timerHandle));
+        EXPECT_EQ(0u, timerWheel.GetStats().GetNumTimers());
+    }
+
+    TEST_F(TimerWheelTests, RepetitiveTimerDoesNotDrift) {
+        TimerWheel timerWheel;
+
+        std::vector<std::chrono::steady_clock::duration> callTimes;
+        callTimes.reserve(200);
+        auto startTime = std::chrono::steady_clock::now();
+        timerWheel.AddRepetitiveTimer(5ms, 150, [&]() {
+            callTimes.push_back(std::chrono::steady_clock::now() - startTime);
+            // Make every call a little slow, this must not push back the following deadlines
+            std::this_thread::sleep_for(1ms);
+        }, 0ms, MissedTickPolicy::Burst);
+
+        // Every wakeup is a little late, but the lateness does not add up, so the 150th call is still close to 750ms
+        std::this_thread::sleep_until(startTime + 800ms);
+        ASSERT_EQ(150u, callTimes.size());
+        EXPECT_GE(callTimes.back(), 750ms);
+        EXPECT_LT(callTimes.back(), 755ms);
+    }
+
+    /// \brief      Runs a 10ms repetitive timer for 300ms, where the first call blocks the timer wheel thread for
+    ///             105ms. Returns the times of the calls, relative to when the timer was added.
+    std::vector<std::chrono::steady_clock::duration> RunMissedTicks(MissedTickPolicy missedTickPolicy,
+                                                                    uint64_t& numMissedTicks) {
+        std::vector<std::chrono::steady_clock::duration> callTimes;
+        callTimes.reserve(100);
+        TimerWheel timerWheel;
+        auto startTime = std::chrono::steady_clock::now();
+        auto timerHandle = timerWheel.AddRepetitiveTimer(10ms, -1, [&]() {
+            callTimes.push_back(std::chrono::steady_clock::now() - startTime);
+            if(callTimes.size() == 1)
+                std::this_thread::sleep_for(105ms);
+        }, 0ms, missedTickPolicy);
+
+        std::this_thread::sleep_until(startTime + 305ms);
+        numMissedTicks = timerWheel.GetNumMissedTicks(timerHandle);
+        EXPECT_EQ(numMissedTicks, timerWheel.GetStats().GetNumMissedTicks());
+        timerWheel.RemoveTimer(timerHandle);
+        return callTimes;
+    }
+
+    TEST_F(TimerWheelTests, MissedTickPolicySkip) {
+        uint64_t numMissedTicks = 0;
+        auto callTimes = RunMissedTicks(MissedTickPolicy::Skip, numMissedTicks);
+
+        // The deadlines from 30 to 110ms are skipped, the one at 20ms is called late and the rest keep their phase,
+        // so the call after the late one is at 120ms
+        EXPECT_GE(numMissedTicks, 9u);
+        EXPECT_LE(numMissedTicks, 10u);
+        ASSERT_GE(callTimes.size(), 3u);
+        EXPECT_LT(callTimes[2] - callTimes[1], 9ms);
+        EXPECT_GE(callTimes.size(), 20u);
+        EXPECT_LE(callTimes.size(), 21u);
+    }
+
+    TEST_F(TimerWheelTests, MissedTickPolicyBurst) {
+        uint64_t numMissedTicks = 0;
+        auto callTimes = RunMissedTicks(MissedTickPolicy::Burst, numMissedTicks);
+
+        // Every deadline is called, the ones from 20 to 110ms on consecutive ticks straight after the slow call
+        EXPECT_EQ(0u, numMissedTicks);
+        EXPECT_GE(callTimes.size(), 29u);
+        EXPECT_LE(callTimes.size(), 30u);
+        ASSERT_GE(callTimes.size(), 11u);
+        EXPECT_LT(callTimes[10] - callTimes[1], 20ms);
+    }
+
+    TEST_F(TimerWheelTests, MissedTickPolicyFireOnce) {
+        uint64_t numMissedTicks = 0;
+        auto callTimes = RunMissedTicks(MissedTickPolicy::FireOnce, numMissedTicks);
+
+        // The late call is made once, and the next deadline is a whole period after it
+        EXPECT_GE(numMissedTicks, 9u);
+        EXPECT_LE(numMissedTicks, 10u);
+        ASSERT_GE(callTimes.size(), 3u);
+        EXPECT_GE(callTimes[2] - callTimes[1], 9ms);
+        EXPECT_GE(callTimes.size(), 19u);
+        EXPECT_LE(callTimes.size(), 20u);
+    }
+
+    TEST_F(TimerWheelTests, InvalidNumRepetitionsExceptionTest) {
+        TimerWheel timerWheel;
+
+        EXPECT_THROW(timerWheel.AddRepetitiveTimer(100ms, 0, [&]() {}), std::invalid_argument);
+        EXPECT_THROW(timerWheel.AddRepetitiveTimer(100ms, -2, [&]() {}), std::invalid_argument);
+    }
+
+    TEST_F(TimerWheelTests, NegativeSlackExceptionTest) {
+        TimerWheel timerWheel;
+
+        EXPECT_THROW(timerWheel.AddSingleShotTimer(100ms, [&]() {}, -1ms),
+                     std::invalid_argument);
+    }
+
+    TEST_F(TimerWheelTests, InvalidWheelConfigExceptionTest) {
+        EXPECT_THROW(TimerWheel(0us), std::invalid_argument);
+        EXPECT_THROW(TimerWheel(1ms, 0), std::invalid_argument);
+        EXPECT_THROW(TimerWheel(1ms, TimerWheel::MAX_NUM_LEVELS + 1), std::invalid_argument);
+    }
+
 }  // namespace
\ No newline at end of file
@@ -0,0 +1,161 @@
+///
+/// \file 				WaitSetTests.cpp
+/// \author 			Geoffrey Hunter (www.mbedded.ninja) <gbmhunter@gmail.com>
+/// \edited             n/a
+/// \created			2026-10-17
+/// \last-modified		2026-10-17
+/// \brief 				Contains tests for the WaitSet class.
+/// \details
+///		See README.md in root dir for more info.
+
+// System includes
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// 3rd party includes
+#include "gtest/gtest.h"
+
+// User includes
+#include "CppUtils/FutexSemaphore.hpp"
+#include "CppUtils/MsgQueue.hpp"
+#include "CppUtils/Semaphore.hpp"
+#include "CppUtils/ThreadSafeQueue.hpp"
+#include "CppUtils/WaitSet.hpp"
+
+using namespace std::literals;
+using namespace mn::CppUtils;
+
+namespace {
+
+    class WaitSetTests : public ::testing::Test {
+    protected:
+        WaitSetTests() {}
+        virtual ~WaitSetTests() {}
+    };
+
+    TEST_F(WaitSetTests, ReadySourceReturnsImmediately) {
+        Semaphore semaphore0;
+        Semaphore semaphore1;
+        semaphore1.Notify();
+
+        WaitSet waitSet;
+        EXPECT_EQ(0u, waitSet.Add(semaphore0));
+        EXPECT_EQ(1u, waitSet.Add(semaphore1));
+        EXPECT_EQ(2u, waitSet.Size());
+
+        EXPECT_EQ(1u, waitSet.WaitAny());
+    }
+
+    TEST_F(WaitSetTests, WakesWithIndexOfSourceThatBecameReady) {
+        Semaphore semaphore;
+        ThreadSafeQueue<int> queue;
+        MsgQueue::MsgQueue msgQueue;
+
+        WaitSet waitSet;
+        waitSet.Add(semaphore);
+        waitSet.Add(queue);
+        waitSet.Add(msgQueue);
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread t1([&]() {
+            std::this_thread::sleep_for(50ms);
+            msgQueue.Push(MsgQueue::TxMsg("HELLO"));
+        });
+
+        EXPECT_EQ(2u, waitSet.WaitAny());
+        EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+
+        MsgQueue::RxMsg msg;
+        EXPECT_TRUE(msgQueue.TryPop(msg, 0ms));
+        EXPECT_EQ("HELLO", msg.GetId());
+
+        t1.join();
+    }
+
+    TEST_F(WaitSetTests, TryWaitAnyTimesOut) {
+        FutexSemaphore semaphore;
+        ThreadSafeQueue<int> queue;
+
+        WaitSet waitSet;
+        waitSet.Add(semaphore);
+        waitSet.Add(queue);
+
+        std::size_t index;
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(waitSet.TryWaitAny(index, 50ms));
+        EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+
+        semaphore.Notify();
+        EXPECT_TRUE(waitSet.TryWaitAny(index, 50ms));
+        EXPECT_EQ(0u, index);
+    }
+
+    TEST_F(WaitSetTests, ReadySourcesAreReturnedRoundRobin) {
+        Semaphore semaphore0;
+        Semaphore semaphore1;
+        semaphore0.Notify(10);
+        semaphore1.Notify(10);
+
+        WaitSet waitSet;
+        waitSet.Add(semaphore0);
+        waitSet.Add(semaphore1);
+
+        // Without taking anything, both stay ready, and neither is returned twice in a row
+        EXPECT_EQ(0u, waitSet.WaitAny());
+        EXPECT_EQ(1u, waitSet.WaitAny());
+        EXPECT_EQ(0u, waitSet.WaitAny());
+        EXPECT_EQ(1u, waitSet.WaitAny());
+    }
+
+    TEST_F(WaitSetTests, OneThreadServesManySources) {
+        constexpr int NUM_SOURCES = 4;
+        constexpr int NUM_ITEMS_PER_SOURCE = 10000;
+        std::vector<ThreadSafeQueue<int>> queues(NUM_SOURCES);
+
+        WaitSet waitSet;
+        for(auto& queue : queues)
+            waitSet.Add(queue);
+
+        std::vector<std::thread> producers;
+        for(int i = 0; i < NUM_SOURCES; i++) {
+            producers.push_back(std::thread([&, i]() {
+                for(int j = 0; j < NUM_ITEMS_PER_SOURCE; j++)
+                    queues[i].Push(j);
+            }));
+        }
+
+        std::vector<int> numItems(NUM_SOURCES, 0);
+        std::vector<int> nextItem(NUM_SOURCES, 0);
+        bool inOrder = true;
+        for(int i = 0; i < NUM_SOURCES * NUM_ITEMS_PER_SOURCE; i++) {
+            auto index = waitSet.WaitAny();
+            int item;
+            ASSERT_TRUE(queues[index].TryPop(item, 0ms));
+            inOrder = inOrder && item == nextItem[index]++;
+            numItems[index]++;
+        }
+
+        for(auto& producer : producers)
+            producer.join();
+
+        EXPECT_TRUE(inOrder);
+        for(int i = 0; i < NUM_SOURCES; i++)
+            EXPECT_EQ(NUM_ITEMS_PER_SOURCE, numItems[i]);
+        std::size_t index;
+        EXPECT_FALSE(waitSet.TryWaitAny(index, 0ms));
+    }
+
+    TEST_F(WaitSetTests, DestroyedWaitSetIsDetached) {
+        Semaphore semaphore;
+        {
+            WaitSet waitSet;
+            waitSet.Add(semaphore);
+        }
+
+        // Must not touch the destroyed WaitSet
+        semaphore.Notify();
+        EXPECT_TRUE(semaphore.TryWait(0ms));
+    }
+
+}  // namespace